@@ -0,0 +1,271 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#define ALLOC_USABLE_SIZE(p) _msize(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define ALLOC_USABLE_SIZE(p) malloc_size(p)
+#else
+#include <malloc.h>
+#define ALLOC_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+
+namespace
+{
+	//
+	// Plain data so that it needs no construction and can be used from inside
+	// the allocator without allocating
+	//
+	struct ThreadCounters
+	{
+		qint64 allocations;
+		qint64 bytes;
+		qint64 live;
+		qint64 peak;
+	};
+
+	thread_local ThreadCounters counters = { 0, 0, 0, 0 };
+	std::atomic<bool> enabled(false);
+
+#ifdef XEROPATH_ALLOC_TRACKING
+	inline void countAllocation(void* p)
+	{
+		if (p != nullptr && enabled.load(std::memory_order_relaxed)) {
+			qint64 size = static_cast<qint64>(ALLOC_USABLE_SIZE(p));
+			counters.allocations++;
+			counters.bytes += size;
+			counters.live += size;
+			if (counters.live > counters.peak) {
+				counters.peak = counters.live;
+			}
+		}
+	}
+
+	inline qint64 usableSize(void* p)
+	{
+		return (p == nullptr) ? 0 : static_cast<qint64>(ALLOC_USABLE_SIZE(p));
+	}
+
+	inline void countFree(qint64 size)
+	{
+		if (enabled.load(std::memory_order_relaxed)) {
+			counters.live -= size;
+		}
+	}
+#endif
+}
+
+AllocationCounter::Scope::Scope()
+{
+	allocations_ = counters.allocations;
+	bytes_ = counters.bytes;
+	live_ = counters.live;
+	peak_ = counters.peak;
+
+	//
+	// The peak is measured from what is live now, the outer scope's peak is put back
+	// when this scope ends
+	//
+	counters.peak = counters.live;
+}
+
+AllocationCounter::Scope::~Scope()
+{
+	if (peak_ > counters.peak) {
+		counters.peak = peak_;
+	}
+}
+
+AllocationStats AllocationCounter::Scope::stats() const
+{
+	AllocationStats ret;
+	ret.allocations = counters.allocations - allocations_;
+	ret.bytes = counters.bytes - bytes_;
+	ret.peak = counters.peak - live_;
+	return ret;
+}
+
+bool AllocationCounter::isAvailable()
+{
+#ifdef XEROPATH_ALLOC_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AllocationCounter::setEnabled(bool enable)
+{
+	enabled = enable && isAvailable();
+}
+
+bool AllocationCounter::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+#ifdef XEROPATH_ALLOC_TRACKING
+
+#if defined(__GLIBC__)
+
+//
+// With glibc the C allocator is replaced, which also catches the Qt containers and
+// QString as they allocate with malloc rather than operator new.  The default
+// operator new calls malloc so it is counted here as well.
+//
+extern "C"
+{
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* p, size_t size);
+	void* __libc_memalign(size_t align, size_t size);
+	void __libc_free(void* p);
+
+	void* malloc(size_t size)
+	{
+		void* p = __libc_malloc(size);
+		countAllocation(p);
+		return p;
+	}
+
+	void* calloc(size_t count, size_t size)
+	{
+		void* p = __libc_calloc(count, size);
+		countAllocation(p);
+		return p;
+	}
+
+	void* realloc(void* old, size_t size)
+	{
+		qint64 oldsize = usableSize(old);
+		void* p = __libc_realloc(old, size);
+
+		//
+		// If the realloc failed the old block is still allocated
+		//
+		if (p != nullptr || size == 0) {
+			countFree(oldsize);
+			countAllocation(p);
+		}
+		return p;
+	}
+
+	void* memalign(size_t align, size_t size)
+	{
+		void* p = __libc_memalign(align, size);
+		countAllocation(p);
+		return p;
+	}
+
+	void* aligned_alloc(size_t align, size_t size)
+	{
+		return memalign(align, size);
+	}
+
+	int posix_memalign(void** ret, size_t align, size_t size)
+	{
+		void* p = __libc_memalign(align, size);
+		if (p == nullptr) {
+			return ENOMEM;
+		}
+
+		countAllocation(p);
+		*ret = p;
+		return 0;
+	}
+
+	void free(void* p)
+	{
+		countFree(usableSize(p));
+		__libc_free(p);
+	}
+}
+
+#else
+
+//
+// Elsewhere only the C++ allocations are counted
+//
+void* operator new(std::size_t size)
+{
+	void* p = std::malloc(size == 0 ? 1 : size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	countAllocation(p);
+	return p;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	void* p = std::malloc(size == 0 ? 1 : size);
+	countAllocation(p);
+	return p;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+	countFree(usableSize(p));
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	operator delete(p);
+}
+
+#endif
+
+#endif
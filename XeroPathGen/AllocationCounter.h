@@ -0,0 +1,70 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+//
+// The heap allocations made by one thread over some span of work
+//
+struct AllocationStats
+{
+	qint64 allocations = 0;			// The number of allocations
+	qint64 bytes = 0;				// The total size of the allocations
+	qint64 peak = 0;				// The most memory, above that at the start, that was live at one time
+};
+
+//
+// Counts heap allocations per thread.  Counting needs the allocation hooks, which are
+// only built when XEROPATH_ALLOC_TRACKING is defined (cmake -DXEROPATH_ALLOC_TRACKING=ON)
+// and even then only count while enabled.  Sizes are those the allocator actually
+// handed out, which may be a little more than was asked for.
+//
+class AllocationCounter
+{
+public:
+	//
+	// Measures the allocations made by the current thread from construction until
+	// stats() is called.  Scopes may be nested.
+	//
+	class Scope
+	{
+	public:
+		Scope();
+		~Scope();
+
+		AllocationStats stats() const;
+
+	private:
+		qint64 allocations_;
+		qint64 bytes_;
+		qint64 live_;
+		qint64 peak_;
+	};
+
+public:
+	AllocationCounter() = delete;
+	~AllocationCounter() = delete;
+
+	//
+	// True if the allocation hooks were built in
+	//
+	static bool isAvailable();
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+};
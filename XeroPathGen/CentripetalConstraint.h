@@ -88,6 +88,10 @@ public:
 	void convert(const QString& from, const QString& to) override {
 	}
 
+	std::shared_ptr<PathConstraint> clone(std::shared_ptr<RobotPath> path) const override {
+		return std::make_shared<CentripetalConstraint>(path, maxcen_);
+	}
+
 	QString toString() const {
 		QString ret;
 
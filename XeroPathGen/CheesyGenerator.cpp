@@ -24,7 +24,9 @@
 #include "RobotParams.h"
 #include "TrapezoidalProfile.h"
 #include "DistanceVelocityConstraint.h"
+#include "Tracer.h"
 #include <cmath>
+#include <algorithm>
 
 CheesyGenerator::CheesyGenerator(const QString &logfile, QMutex& loglock, int which, double diststep, double timestep, double maxdx, double maxdy, double maxtheta, std::shared_ptr<RobotParams> robot, bool xeromode)
 		: GeneratorBase(logfile, loglock, which, diststep, timestep, maxdx, maxdy, maxtheta, robot)
@@ -43,21 +45,38 @@ CheesyGenerator::generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path
 	std::shared_ptr<PathTrajectory> traj;
 
 	logMessage(path->fullname() + ": generating splines");
-	QVector<std::shared_ptr<SplinePair>> splines = generateSplines(path->waypoints());
-	QVector<double> dists = TrajectoryUtils::getDistancesForSplines(splines);
+	QVector<double> dists = path->splines()->distances();
 	assert(dists.size() == path->waypoints().size());
 	bool generating = true;
 
 	QVector<std::shared_ptr<PathConstraint>> extras;
 	QVector<double> percents;
+	QVector<bool> climbing;
+	QVector<double> highest;
 
-	for (int i = 0; i < path->size() - 1; i++) {
-		percents.push_back(1);
+	//
+	// A segment with a percentage from an earlier generation starts one step above it
+	// and climbs while the rotation still fits, so a percentage that still holds is found
+	// again in two iterations.  A segment that fails on its first step searches downward
+	// from there as an unseeded one does from full velocity.
+	//
+	int segcount = path->size() - 1;
+	for (int i = 0; i < segcount; i++) {
+		double seed = seed_.segmentPercent(i, segcount, path->getPoint(i), path->getPoint(i + 1));
+		if (seed > 0.0) {
+			percents.push_back(std::min(1.0, seed + 0.01));
+		}
+		else {
+			percents.push_back(1);
+		}
+		climbing.push_back(percents[i] < 1.0);
+		highest.push_back(0.0);
 	}
 
 	int iteration = 1;
 	bool running = true;
 	while (running) {
+		Tracer::Span span(Tracer::GeneratorCategory, "iteration", path.get());
 		logMessage(path->fullname() + ": iteration " + QString::number(iteration++));
 
 		logtext.clear();
@@ -68,6 +87,9 @@ CheesyGenerator::generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path
 			logtext += QString::number(d, 'f', 2);
 		}
 		logMessage(path->fullname() + ": per seg percentages: " + logtext);
+		if (percents.size() > 0) {
+			setFinalPercent(*std::min_element(percents.begin(), percents.end()));
+		}
 
 		running = false;
 
@@ -86,6 +108,14 @@ CheesyGenerator::generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path
 			return traj;
 		}
 
+		//
+		// The first, linear only, trajectory is shown while the rotation is worked out
+		//
+		if (iteration == 2) {
+			publishProgress(traj);
+		}
+		bool fitsall = true;
+
 		//
 		// Now evaluate if any rotation requested is feasible.  If not, we lower the percentage of velocity for
 		// any given segment available to the linear trajectory to reserve more for the rotation.
@@ -134,10 +164,35 @@ CheesyGenerator::generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path
 			// We now need the trajectory points for the times range
 			//
 
-			if (!modifySegmentForRotation(path, traj, 1.0 - percents[i], startIndex, endIndex, startRot, startRotVel, endRot, endRotVel))
+			bool fits = modifySegmentForRotation(path, traj, 1.0 - percents[i], startIndex, endIndex, startRot, startRotVel, endRot, endRotVel);
+			if (fits && climbing[i] && percents[i] < 1.0)
 			{
+				//
+				// The rotation fits above the earlier percentage, so the next step up is tried
+				//
+				highest[i] = percents[i];
+				percents[i] = std::min(1.0, percents[i] + 0.01);
+				running = true;
+				status.push_back(false);
+			}
+			else if (!fits && climbing[i] && highest[i] > 0.0)
+			{
+				//
+				// The step above the highest percentage that fits does not, so the segment
+				// settles on that one
+				//
+				percents[i] = highest[i];
+				climbing[i] = false;
+				running = true;
+				fitsall = false;
+				status.push_back(false);
+			}
+			else if (!fits)
+			{
+				climbing[i] = false;
 				percents[i] -= 0.01;
 				running = true;
+				fitsall = false;
 
 				if (percents[i] <= 0.0) {
 					//
@@ -162,6 +217,26 @@ CheesyGenerator::generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path
 				logtext += (b ? "success" : "failed");
 			}
 		}
+
+		//
+		// After the linear trajectory, only an iteration whose rotation fits on every
+		// segment is shown, i.e. a step that is still climbing, as the others are not
+		// usable until the rotation fits
+		//
+		if (running && fitsall) {
+			publishProgress(traj);
+		}
+
+		if (running && maxIterations() > 0 && iteration > maxIterations()) {
+			logMessage(path->fullname() + ": stopped after " + QString::number(maxIterations()) + " iterations");
+			break;
+		}
+	}
+
+	if (!running) {
+		for (int i = 0; i < segcount; i++) {
+			warm_start_.addSegment(path->getPoint(i), path->getPoint(i + 1), percents[i]);
+		}
 	}
 
 	return traj;
@@ -173,20 +248,69 @@ CheesyGenerator::generateSwerveSingleRotate(std::shared_ptr<RobotPath> path)
 	std::shared_ptr<PathTrajectory> traj;
 	double percent = 1.0;
 	double maxvel = robotMaxVelocity();
+	int iteration = 1;
 	QVector<std::shared_ptr<PathConstraint>> extras;
 
+	//
+	// Start one step above the percentage of an earlier generation and climb while the
+	// rotation still fits, so a percentage that still holds is found again in two
+	// iterations.  The trajectory of the highest percentage that fits is kept, so the
+	// step that fails above it does not have to be generated again.
+	//
+	if (seed_.singlePercent() > 0.0) {
+		percent = std::min(1.0, seed_.singlePercent() + 0.01);
+	}
+	bool climbing = (percent < 1.0);
+	double highest = 0.0;
+	std::shared_ptr<PathTrajectory> highesttraj;
+
 	while (percent > 0.0)
 	{
 		extras.clear();
 		auto c = std::make_shared<DistanceVelocityConstraint>(path, 0.0, std::numeric_limits<double>::max(), percent * maxvel);
 		extras.push_back(c);
 		traj = generateInternal(path, extras);
+		setFinalPercent(percent);
+
+		//
+		// The first, linear only, trajectory is shown while the rotation is worked out
+		//
+		if (iteration == 1) {
+			publishProgress(traj);
+		}
 
 		if (modifyForRotation(path, traj, 1.0 - percent)) {
+			if (!climbing || percent >= 1.0) {
+				warm_start_.setSinglePercent(percent);
+				break;
+			}
+
+			//
+			// After the linear trajectory, only an iteration whose rotation fits is shown,
+			// i.e. a step that is still climbing, as the others are not usable until the
+			// rotation fits
+			//
+			publishProgress(traj);
+			highest = percent;
+			highesttraj = traj;
+		}
+		else if (climbing && highesttraj != nullptr) {
+			percent = highest;
+			traj = highesttraj;
+			setFinalPercent(percent);
+			warm_start_.setSinglePercent(percent);
+			break;
+		}
+		else {
+			climbing = false;
+		}
+
+		if (maxIterations() > 0 && iteration >= maxIterations()) {
 			break;
 		}
 
-		percent -= 0.01;
+		iteration++;
+		percent = climbing ? std::min(1.0, percent + 0.01) : percent - 0.01;
 	}
 
 	return (percent <= 0.0) ? nullptr : traj;
@@ -234,18 +358,19 @@ CheesyGenerator::generate(std::shared_ptr<RobotPath> path)
 	}
 	logMessage(startmsg);
 
-	//
-	// Compute the robot parameters in terms of the units used by the
-	// path and cache them for future access.
-	//
-	computeRobotParameters(path);
-
 	if (robot()->getDriveType() == RobotParams::DriveType::TankDrive)
 	{
 		traj = generateTankDrive(path);
 	}
 	else
 	{
+		//
+		// Compute the robot parameters in terms of the units used by the
+		// path and cache them for future access.  Only the swerve generators
+		// use them, so a tank drive path does not depend on them.
+		//
+		computeRobotParameters(path);
+
 		if (xeromode_) {
 			traj = generateSwervePerWaypointRotate(path);
 		}
@@ -20,9 +20,10 @@
 #include "PathTrajectory.h"
 #include "Pose2dWithRotation.h"
 #include "Pose2dWithTrajectory.h"
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "DistanceView.h"
 #include "SwerveWheels.h"
+#include "WarmStart.h"
 #include <QtCore/QVector>
 
 class CheesyGenerator : public GeneratorBase
@@ -33,6 +34,22 @@ public:
 
 	std::shared_ptr<PathTrajectory> generate(std::shared_ptr<RobotPath> path);
 
+	//
+	// The percentages of an earlier generation of the path.  The swerve search starts
+	// just above them and only searches further if they no longer fit, or if they fit
+	// at once and so may be lower than they need to be.
+	//
+	void setWarmStart(const WarmStart& seed) {
+		seed_ = seed;
+	}
+
+	//
+	// The percentages the swerve search settled on, empty if it did not finish
+	//
+	const WarmStart& warmStart() const {
+		return warm_start_;
+	}
+
 protected:
 	std::shared_ptr<PathTrajectory> generateSwerveSingleRotate(std::shared_ptr<RobotPath> path);
 	std::shared_ptr<PathTrajectory> generateSwervePerWaypointRotate(std::shared_ptr<RobotPath> path);
@@ -40,5 +57,7 @@ protected:
 
 private:
 	bool xeromode_;
+	WarmStart seed_;
+	WarmStart warm_start_;
 };
 
@@ -81,6 +81,10 @@ public:
 		path()->afterConstraintChanged();
 	}
 
+	std::shared_ptr<PathConstraint> clone(std::shared_ptr<RobotPath> path) const override {
+		return std::make_shared<DistanceVelocityConstraint>(path, after_distance_, before_distance_, velocity_);
+	}
+
 	QString toString() const override {
 		QString ret;
 
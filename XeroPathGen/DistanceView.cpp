@@ -14,35 +14,107 @@
 // limitations under the License.
 //
 #include "DistanceView.h"
-#include "TrajectoryUtils.h"
+#include "MathUtils.h"
+#include <algorithm>
+#include <cmath>
 
 DistanceView::DistanceView(const QVector<Pose2dWithRotation>& points, double step)
 {
-	static const double kEpsilon = 1e-6;
 	double d;
 
-	distances_.push_back(0.0);
-	for (int i = 1; i < points.size(); i++)
-		distances_.push_back(points[i].distance(points[i - 1]) + distances_[i - 1]);
+	QVector<double> dists = cumulativeDistances(points);
 
 	int index = 0;
-	for (d = 0.0; d <= distances_.back(); d += step)
+	for (d = 0.0; d <= dists.back(); d += step)
 	{
-		while (d > distances_[index + 1])
+		while (d > dists[index + 1])
 			index++;
 
-		double percent = (d - distances_[index]) / (distances_[index + 1] - distances_[index]);
-		Pose2dWithRotation newpt = points[index].interpolate(points[index + 1], percent);
-		points_.push_back(newpt);
+		points_.push_back(interpolate(points, dists, index, d));
+	}
+
+	finish();
+}
+
+DistanceView::DistanceView(const QVector<Pose2dWithRotation>& points, double minstep, double maxstep, double maxturn, const QVector<double>& rotrates)
+{
+	static const double kEpsilon = 1e-9;
+
+	QVector<double> dists = cumulativeDistances(points);
+
+	//
+	// The longest step allowed within each segment of the points, from how fast the
+	// heading and the rotation of the robot turn along it
+	//
+	QVector<double> allowed;
+	for (int i = 0; i < points.size() - 1; i++) {
+		double len = dists[i + 1] - dists[i];
+		double rate = 0.0;
+
+		if (len > kEpsilon) {
+			double turn = MathUtils::BoundRadians(points[i + 1].getRotation().toRadians() - points[i].getRotation().toRadians());
+			rate = std::fabs(turn) / len;
+		}
+
+		if (i < rotrates.size()) {
+			rate += rotrates[i];
+		}
+
+		double step = (rate > kEpsilon) ? maxturn / rate : maxstep;
+		allowed.push_back(std::clamp(step, minstep, maxstep));
 	}
 
-	distances_.clear();
-	distances_.push_back(0.0);
-	for (int i = 1; i < points_.size(); i++)
-		distances_.push_back(points_[i].distance(points_[i - 1]) + distances_[i - 1]);
+	int index = 0;
+	double d = 0.0;
+	while (true)
+	{
+		while (index < dists.size() - 2 && d > dists[index + 1])
+			index++;
+
+		points_.push_back(interpolate(points, dists, index, d));
+		if (d >= dists.back())
+			break;
+
+		//
+		// A step is no longer than any segment it reaches allows, and the last step
+		// ends on the last point rather than leaving a sliver of the path behind
+		//
+		double step = maxstep;
+		for (int k = index; k < allowed.size() && dists[k] < d + step; k++)
+			step = std::min(step, allowed[k]);
 
-	TrajectoryUtils::computeCurvature(points_);
+		if (dists.back() - (d + step) < minstep / 2.0)
+			step = dists.back() - d;
 
+		d += step;
+	}
+
+	finish();
+}
+
+QVector<double> DistanceView::cumulativeDistances(const QVector<Pose2dWithRotation>& points)
+{
+	QVector<double> dists;
+
+	dists.push_back(0.0);
+	for (int i = 1; i < points.size(); i++)
+		dists.push_back(points[i].distance(points[i - 1]) + dists[i - 1]);
+
+	return dists;
+}
+
+Pose2dWithRotation DistanceView::interpolate(const QVector<Pose2dWithRotation>& points, const QVector<double>& dists, int index, double d)
+{
+	if (index + 1 >= points.size())
+		return points[index];
+
+	double percent = (d - dists[index]) / (dists[index + 1] - dists[index]);
+	return points[index].interpolate(points[index + 1], percent);
+}
+
+void DistanceView::finish()
+{
+	distances_ = cumulativeDistances(points_);
 }
 
 Pose2dWithRotation DistanceView::operator[](double dist) const
@@ -23,6 +23,15 @@ class DistanceView
 {
 public:
 	DistanceView(const QVector<Pose2dWithRotation>& points, double delta);
+
+	//
+	// An adaptive view, whose step is as long as possible between minstep and maxstep
+	// while the heading plus the rotation of the robot turns at most maxturn radians
+	// per step.  The rotation rates are in radians per unit of distance, one for the
+	// segment that starts at each point, and may be empty.
+	//
+	DistanceView(const QVector<Pose2dWithRotation>& points, double minstep, double maxstep, double maxturn, const QVector<double>& rotrates);
+
 	double length() const {
 		return distances_.back();
 	}
@@ -37,6 +46,11 @@ public:
 		return points_.size();
 	}
 
+private:
+	static QVector<double> cumulativeDistances(const QVector<Pose2dWithRotation>& points);
+	static Pose2dWithRotation interpolate(const QVector<Pose2dWithRotation>& points, const QVector<double>& dists, int index, double d);
+	void finish();
+
 private:
 	QVector<double> distances_;
 	QVector<Pose2dWithRotation> points_;
@@ -0,0 +1,108 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "EditLatency.h"
+#include "GenerationMetrics.h"
+
+EditLatency::EditLatency(int window)
+{
+	window_ = (window < 1) ? 1 : window;
+}
+
+bool EditLatency::record(std::shared_ptr<TrajectoryGroup> group, qint64 displayed)
+{
+	using Event = TrajectoryGroup::Event;
+
+	qint64 changed = group->timestamp(Event::Changed);
+	if (changed == 0) {
+		return false;
+	}
+
+	std::array<double, StageCount> sample;
+	sample[static_cast<int>(Stage::Model)] = (group->timestamp(Event::Queued) - changed) / 1.0e9;
+	sample[static_cast<int>(Stage::Queue)] = (group->timestamp(Event::Started) - group->timestamp(Event::Queued)) / 1.0e9;
+	sample[static_cast<int>(Stage::Generate)] = (group->timestamp(Event::Generated) - group->timestamp(Event::Started)) / 1.0e9;
+	sample[static_cast<int>(Stage::Deliver)] = (group->timestamp(Event::Delivered) - group->timestamp(Event::Generated)) / 1.0e9;
+	sample[static_cast<int>(Stage::Display)] = (displayed - group->timestamp(Event::Delivered)) / 1.0e9;
+	sample[static_cast<int>(Stage::Total)] = (displayed - changed) / 1.0e9;
+
+	samples_.push_back(sample);
+	while (samples_.size() > window_) {
+		samples_.pop_front();
+	}
+
+	return true;
+}
+
+void EditLatency::clear()
+{
+	samples_.clear();
+}
+
+double EditLatency::last(Stage stage) const
+{
+	if (samples_.size() == 0)
+		return 0.0;
+
+	return samples_.back()[static_cast<int>(stage)];
+}
+
+double EditLatency::p95(Stage stage) const
+{
+	QVector<double> values;
+	for (const auto& sample : samples_) {
+		values.push_back(sample[static_cast<int>(stage)]);
+	}
+
+	return GenerationMetrics::percentile(values, 95.0);
+}
+
+QString EditLatency::toText() const
+{
+	QString ret = QString("edit latency").leftJustified(12) + QString("last ms").rightJustified(9) + QString("p95 ms").rightJustified(9);
+
+	for (int i = 0; i < StageCount; i++) {
+		Stage stage = static_cast<Stage>(i);
+		ret += "\n";
+		ret += QString(stageName(stage)).leftJustified(12);
+		ret += QString::number(last(stage) * 1000.0, 'f', 1).rightJustified(9);
+		ret += QString::number(p95(stage) * 1000.0, 'f', 1).rightJustified(9);
+	}
+
+	return ret;
+}
+
+const char* EditLatency::stageName(Stage stage)
+{
+	switch (stage) {
+	case Stage::Model:
+		return "model";
+	case Stage::Queue:
+		return "queue";
+	case Stage::Generate:
+		return "generate";
+	case Stage::Deliver:
+		return "deliver";
+	case Stage::Display:
+		return "display";
+	case Stage::Total:
+		return "total";
+	default:
+		break;
+	}
+
+	return "unknown";
+}
@@ -0,0 +1,77 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include "TrajectoryGroup.h"
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <array>
+
+//
+// The latency from a change to a path until the trajectory generated for the change
+// is displayed, split into the stages it passes through.  Only groups generated
+// because of an edit are measured.
+//
+class EditLatency
+{
+public:
+	enum class Stage : int
+	{
+		Model,					// Path changed until it was queued for generation
+		Queue,					// Waiting for a generator thread
+		Generate,				// Generating the trajectories
+		Deliver,				// Handing the result back to the GUI thread
+		Display,				// Updating the windows that show the result
+		Total,
+		Count
+	};
+
+	static constexpr int StageCount = static_cast<int>(Stage::Count);
+	static constexpr int DefaultWindow = 100;
+
+public:
+	EditLatency(int window = DefaultWindow);
+
+	//
+	// Records the latency of a group that was displayed at the time given, on the
+	// Tracer clock.  Returns false if the group was not generated because of an edit.
+	//
+	bool record(std::shared_ptr<TrajectoryGroup> group, qint64 displayed);
+	void clear();
+
+	int count() const {
+		return samples_.size();
+	}
+
+	//
+	// The latency, in seconds, of a stage for the most recent edit and the 95th
+	// percentile over the recent edits
+	//
+	double last(Stage stage) const;
+	double p95(Stage stage) const;
+
+	//
+	// A few lines of text with the last and p95 latency of each stage
+	//
+	QString toText() const;
+
+	static const char* stageName(Stage stage);
+
+private:
+	QList<std::array<double, StageCount>> samples_;
+	int window_;
+};
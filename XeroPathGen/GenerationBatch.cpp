@@ -0,0 +1,124 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "GenerationBatch.h"
+#include "GenerationMgr.h"
+#include "TrajectoryNames.h"
+#include "Tracer.h"
+#include <QtCore/QEventLoop>
+
+GenerationBatch::GenerationBatch(GenerationMgr& mgr, const QVector<std::shared_ptr<RobotPath>>& paths) : mgr_(mgr)
+{
+	id_ = 0;
+	paths_ = paths;
+	for (auto path : paths_) {
+		remaining_.insert(path.get());
+	}
+
+	total_ = remaining_.size();
+	started_ = Tracer::now();
+	completed_ = 0;
+	failed_ = 0;
+	finished_ = (remaining_.size() == 0);
+	canceled_ = false;
+}
+
+void GenerationBatch::cancel()
+{
+	if (finished_) {
+		return;
+	}
+
+	canceled_ = true;
+
+	if (id_ != 0) {
+		mgr_.cancelBatch(id_);
+	}
+
+	finish();
+}
+
+bool GenerationBatch::wait()
+{
+	if (!finished_) {
+		QEventLoop loop;
+		connect(this, &GenerationBatch::finished, &loop, &QEventLoop::quit);
+		loop.exec();
+	}
+
+	return !canceled_;
+}
+
+void GenerationBatch::pathFinished(std::shared_ptr<TrajectoryGroup> group)
+{
+	//
+	// A generation queued before the batch was created does not include the request
+	// made by the batch, so the batch keeps waiting for the one that does
+	//
+	if (finished_ || !remaining_.contains(group->path().get()) || group->timestamp(TrajectoryGroup::Event::Queued) < started_) {
+		return;
+	}
+
+	addGroup(group);
+}
+
+void GenerationBatch::addGroup(std::shared_ptr<TrajectoryGroup> group)
+{
+	if (finished_ || !remaining_.contains(group->path().get())) {
+		return;
+	}
+
+	remaining_.remove(group->path().get());
+	groups_.insert(group->path().get(), group);
+	completed_++;
+	if (group->hasError() || group->getTrajectory(TrajectoryName::Main) == nullptr) {
+		failed_++;
+	}
+
+	emit pathComplete(group->path());
+	emit progress(completed_, total_);
+
+	if (remaining_.size() == 0) {
+		finish();
+	}
+}
+
+void GenerationBatch::pathRemoved(std::shared_ptr<RobotPath> path)
+{
+	if (finished_ || !remaining_.contains(path.get())) {
+		return;
+	}
+
+	//
+	// A path removed from the queue, e.g. because it was deleted, will never complete
+	// and is counted as failed
+	//
+	remaining_.remove(path.get());
+	completed_++;
+	failed_++;
+
+	emit progress(completed_, total_);
+
+	if (remaining_.size() == 0) {
+		finish();
+	}
+}
+
+void GenerationBatch::finish()
+{
+	remaining_.clear();
+	finished_ = true;
+	emit finished();
+}
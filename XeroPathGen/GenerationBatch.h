@@ -0,0 +1,111 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "RobotPath.h"
+#include "TrajectoryGroup.h"
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QMap>
+#include <QtCore/QVector>
+#include <memory>
+
+class GenerationMgr;
+
+//
+// A set of paths queued for generation together, e.g. every path before the output
+// files are written.  It counts the paths as they complete and signals when all of
+// them have, so callers can wait for the set without polling the generation manager.
+// A batch is used on the thread its generation manager lives on.
+//
+class GenerationBatch : public QObject
+{
+	friend class GenerationMgr;
+
+	Q_OBJECT
+
+public:
+	GenerationBatch(GenerationMgr& mgr, const QVector<std::shared_ptr<RobotPath>>& paths);
+
+	const QVector<std::shared_ptr<RobotPath>>& paths() const {
+		return paths_;
+	}
+
+	int total() const {
+		return total_;
+	}
+
+	int completed() const {
+		return completed_;
+	}
+
+	int failed() const {
+		return failed_;
+	}
+
+	bool isFinished() const {
+		return finished_;
+	}
+
+	bool isCanceled() const {
+		return canceled_;
+	}
+
+	//
+	// The group generated for a path of the batch.  The batch holds on to its groups,
+	// so they stay available even if the generation manager has dropped them to stay
+	// within its memory budget.
+	//
+	std::shared_ptr<TrajectoryGroup> group(std::shared_ptr<RobotPath> path) const {
+		return groups_.value(path.get());
+	}
+
+	//
+	// Stops waiting for the paths and finishes the batch.  Requests made by this batch
+	// alone that have not started generating are removed from the queue.  Any other
+	// request for the paths, e.g. one for an edit, still completes.
+	//
+	void cancel();
+
+	//
+	// Runs a local event loop until the batch finishes, returns false if it was canceled
+	//
+	bool wait();
+
+signals:
+	void pathComplete(std::shared_ptr<RobotPath> path);
+	void progress(int completed, int total);
+	void finished();
+
+private:
+	void pathFinished(std::shared_ptr<TrajectoryGroup> group);
+	void addGroup(std::shared_ptr<TrajectoryGroup> group);
+	void pathRemoved(std::shared_ptr<RobotPath> path);
+	void finish();
+
+private:
+	GenerationMgr& mgr_;
+	quint64 id_;
+	QVector<std::shared_ptr<RobotPath>> paths_;
+	QSet<const RobotPath*> remaining_;
+	QMap<const RobotPath*, std::shared_ptr<TrajectoryGroup>> groups_;
+	int total_;
+	qint64 started_;
+	int completed_;
+	int failed_;
+	bool finished_;
+	bool canceled_;
+};
@@ -0,0 +1,242 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "GenerationCapture.h"
+#include "RobotManager.h"
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+GenerationCapture::GenerationCapture()
+{
+	type_ = GeneratorType::None;
+	timestep_ = 0.0;
+	resolution_ = { 0.0, 0.0, 0.0, 0.0, false, 0.0, 0.0, 0.0 };
+}
+
+bool GenerationCapture::write(const QString& filename, std::shared_ptr<RobotPath> path, GeneratorType type, std::shared_ptr<RobotParams> robot,
+	double timestep, const Generator::Resolution& res, const WarmStart& seed, QString& msg)
+{
+	QJsonObject obj;
+
+	obj[VersionTag] = "1";
+	obj[GroupTag] = path->pathGroup()->name();
+	obj[UnitsTag] = path->units();
+	obj[PathTag] = path->toJSONObject();
+	obj[RobotTag] = RobotManager::toJSONObject(robot);
+	obj[GeneratorTag] = typeToKey(type);
+	obj[TimestepTag] = timestep;
+	obj[DistStepTag] = res.diststep;
+	obj[MaxDxTag] = res.maxdx;
+	obj[MaxDyTag] = res.maxdy;
+	obj[MaxThetaTag] = res.maxtheta;
+
+	//
+	// The adaptive steps are only written when they are used, so captures of fixed
+	// steps read the same as before
+	//
+	if (res.adaptive) {
+		obj[MinStepTag] = res.minstep;
+		obj[MaxStepTag] = res.maxstep;
+		obj[MaxTurnTag] = res.maxturn;
+	}
+
+	//
+	// The seed changes the iterations a swerve generation takes, so it is written
+	// whenever the generation had one
+	//
+	if (!seed.isEmpty()) {
+		obj[WarmStartTag] = warmStartToJSON(seed);
+	}
+
+	QFile file(filename);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		msg = "cannot open file '" + filename + "' for writing";
+		return false;
+	}
+
+	file.write(QJsonDocument(obj).toJson());
+	file.close();
+
+	return true;
+}
+
+bool GenerationCapture::read(const QString& filename, QString& msg)
+{
+	msg.clear();
+
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		msg = "cannot open file '" + filename + "' for reading";
+		return false;
+	}
+
+	QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+	file.close();
+
+	if (!doc.isObject()) {
+		msg = "file '" + filename + "' is not a JSON object";
+		return false;
+	}
+
+	QJsonObject obj = doc.object();
+
+	const char* numbers[] = { TimestepTag, DistStepTag, MaxDxTag, MaxDyTag, MaxThetaTag };
+	for (const char* tag : numbers) {
+		if (!obj.value(tag).isDouble()) {
+			msg = "capture has no numeric '" + QString(tag) + "' value";
+			return false;
+		}
+	}
+
+	if (!obj.value(GroupTag).isString() || !obj.value(UnitsTag).isString() || !obj.value(GeneratorTag).isString() ||
+		!obj.value(PathTag).isObject() || !obj.value(RobotTag).isObject()) {
+		msg = "capture is missing the group, units, generator, path or robot";
+		return false;
+	}
+
+	type_ = keyToType(obj.value(GeneratorTag).toString());
+	if (type_ == GeneratorType::None) {
+		msg = "capture has an unknown generator '" + obj.value(GeneratorTag).toString() + "'";
+		return false;
+	}
+
+	robot_ = RobotManager::fromJSONObject(obj.value(RobotTag).toObject(), msg);
+	if (robot_ == nullptr) {
+		return false;
+	}
+
+	group_ = std::make_shared<PathGroup>(obj.value(GroupTag).toString());
+	path_ = RobotPath::fromJSONObject(group_.get(), obj.value(UnitsTag).toString(), obj.value(PathTag).toObject(), msg);
+	if (path_ == nullptr) {
+		return false;
+	}
+	group_->addPath(path_);
+
+	timestep_ = obj.value(TimestepTag).toDouble();
+	resolution_.diststep = obj.value(DistStepTag).toDouble();
+	resolution_.maxdx = obj.value(MaxDxTag).toDouble();
+	resolution_.maxdy = obj.value(MaxDyTag).toDouble();
+	resolution_.maxtheta = obj.value(MaxThetaTag).toDouble();
+
+	resolution_.adaptive = obj.contains(MaxTurnTag);
+	if (resolution_.adaptive) {
+		if (!obj.value(MinStepTag).isDouble() || !obj.value(MaxStepTag).isDouble() || !obj.value(MaxTurnTag).isDouble()) {
+			msg = "capture has adaptive steps that are not all numbers";
+			return false;
+		}
+
+		resolution_.minstep = obj.value(MinStepTag).toDouble();
+		resolution_.maxstep = obj.value(MaxStepTag).toDouble();
+		resolution_.maxturn = obj.value(MaxTurnTag).toDouble();
+	}
+	else {
+		resolution_.minstep = resolution_.diststep;
+		resolution_.maxstep = resolution_.diststep;
+		resolution_.maxturn = 0.0;
+	}
+
+	warm_start_ = WarmStart();
+	if (obj.contains(WarmStartTag)) {
+		if (!obj.value(WarmStartTag).isObject() || !warmStartFromJSON(obj.value(WarmStartTag).toObject(), warm_start_, msg)) {
+			if (msg.length() == 0) {
+				msg = "capture has a '" + QString(WarmStartTag) + "' value that is not a JSON object";
+			}
+			return false;
+		}
+	}
+
+	return true;
+}
+
+QJsonObject GenerationCapture::poseToJSON(const Pose2dWithRotation& pose)
+{
+	QJsonObject obj;
+
+	obj[RobotPath::XTag] = pose.getTranslation().getX();
+	obj[RobotPath::YTag] = pose.getTranslation().getY();
+	obj[RobotPath::HeadingTag] = pose.getRotation().toDegrees();
+	obj[RobotPath::SwerveRotationTag] = pose.getSwrot().toDegrees();
+	obj[RobotPath::SwerveRotationVelocityTag] = pose.getSwrotVelocity();
+
+	return obj;
+}
+
+//
+// The waypoints are written and read the same way as the path, so the segments of a
+// seed match the waypoints of the captured path exactly
+//
+bool GenerationCapture::poseFromJSON(const QJsonObject& obj, Pose2dWithRotation& pose)
+{
+	const char* numbers[] = { RobotPath::XTag, RobotPath::YTag, RobotPath::HeadingTag, RobotPath::SwerveRotationTag, RobotPath::SwerveRotationVelocityTag };
+	for (const char* tag : numbers) {
+		if (!obj.value(tag).isDouble()) {
+			return false;
+		}
+	}
+
+	pose = Pose2dWithRotation(Translation2d(obj.value(RobotPath::XTag).toDouble(), obj.value(RobotPath::YTag).toDouble()),
+		Rotation2d::fromDegrees(obj.value(RobotPath::HeadingTag).toDouble()), Rotation2d::fromDegrees(obj.value(RobotPath::SwerveRotationTag).toDouble()));
+	pose.setRotVelocity(obj.value(RobotPath::SwerveRotationVelocityTag).toDouble());
+
+	return true;
+}
+
+QJsonObject GenerationCapture::warmStartToJSON(const WarmStart& seed)
+{
+	QJsonObject obj;
+	QJsonArray segments;
+
+	for (const WarmStart::Segment& seg : seed.segments()) {
+		QJsonObject segobj;
+		segobj[FromTag] = poseToJSON(seg.from);
+		segobj[ToTag] = poseToJSON(seg.to);
+		segobj[PercentTag] = seg.percent;
+		segments.push_back(segobj);
+	}
+
+	obj[SinglePercentTag] = seed.singlePercent();
+	obj[SegmentsTag] = segments;
+
+	return obj;
+}
+
+bool GenerationCapture::warmStartFromJSON(const QJsonObject& obj, WarmStart& seed, QString& msg)
+{
+	if (!obj.value(SinglePercentTag).isDouble() || !obj.value(SegmentsTag).isArray()) {
+		msg = "capture has a warm start without a single percentage or segments";
+		return false;
+	}
+
+	seed.setSinglePercent(obj.value(SinglePercentTag).toDouble());
+
+	QJsonArray segments = obj.value(SegmentsTag).toArray();
+	for (int i = 0; i < segments.count(); i++) {
+		QJsonObject segobj = segments.at(i).toObject();
+		Pose2dWithRotation from, to;
+
+		if (!segobj.value(FromTag).isObject() || !segobj.value(ToTag).isObject() || !segobj.value(PercentTag).isDouble() ||
+			!poseFromJSON(segobj.value(FromTag).toObject(), from) || !poseFromJSON(segobj.value(ToTag).toObject(), to)) {
+			msg = "warm start segment " + QString::number(i + 1) + " is not a pair of waypoints and a percentage";
+			return false;
+		}
+
+		seed.addSegment(from, to, segobj.value(PercentTag).toDouble());
+	}
+
+	return true;
+}
@@ -0,0 +1,109 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include "Generator.h"
+#include "GeneratorType.h"
+#include "PathGroup.h"
+#include "RobotParams.h"
+#include "RobotPath.h"
+#include "WarmStart.h"
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <memory>
+
+//
+// A self contained record of everything one generation used: the path, the robot,
+// the generator, the timestep and the resolution.  Generating from a capture gives
+// the same result as the original without the project it came from.
+//
+class GenerationCapture
+{
+public:
+	static constexpr const char* Extension = "xeroreplay";
+
+	static constexpr const char* VersionTag = "_version";
+	static constexpr const char* GroupTag = "group";
+	static constexpr const char* UnitsTag = "units";
+	static constexpr const char* PathTag = "path";
+	static constexpr const char* RobotTag = "robot";
+	static constexpr const char* GeneratorTag = "generator";
+	static constexpr const char* TimestepTag = "timestep";
+	static constexpr const char* DistStepTag = "diststep";
+	static constexpr const char* MaxDxTag = "maxdx";
+	static constexpr const char* MaxDyTag = "maxdy";
+	static constexpr const char* MaxThetaTag = "maxtheta";
+	static constexpr const char* MinStepTag = "minstep";
+	static constexpr const char* MaxStepTag = "maxstep";
+	static constexpr const char* MaxTurnTag = "maxturn";
+	static constexpr const char* WarmStartTag = "warmstart";
+	static constexpr const char* SinglePercentTag = "single";
+	static constexpr const char* SegmentsTag = "segments";
+	static constexpr const char* FromTag = "from";
+	static constexpr const char* ToTag = "to";
+	static constexpr const char* PercentTag = "percent";
+
+public:
+	GenerationCapture();
+
+	static bool write(const QString& filename, std::shared_ptr<RobotPath> path, GeneratorType type, std::shared_ptr<RobotParams> robot,
+		double timestep, const Generator::Resolution& res, const WarmStart& seed, QString& msg);
+
+	bool read(const QString& filename, QString& msg);
+
+	std::shared_ptr<RobotPath> path() {
+		return path_;
+	}
+
+	std::shared_ptr<RobotParams> robot() {
+		return robot_;
+	}
+
+	GeneratorType type() const {
+		return type_;
+	}
+
+	double timestep() const {
+		return timestep_;
+	}
+
+	const Generator::Resolution& resolution() const {
+		return resolution_;
+	}
+
+	//
+	// The swerve percentages the captured generation started its search from
+	//
+	const WarmStart& warmStart() const {
+		return warm_start_;
+	}
+
+private:
+	static QJsonObject poseToJSON(const Pose2dWithRotation& pose);
+	static bool poseFromJSON(const QJsonObject& obj, Pose2dWithRotation& pose);
+	static QJsonObject warmStartToJSON(const WarmStart& seed);
+	static bool warmStartFromJSON(const QJsonObject& obj, WarmStart& seed, QString& msg);
+
+private:
+	std::shared_ptr<PathGroup> group_;
+	std::shared_ptr<RobotPath> path_;
+	std::shared_ptr<RobotParams> robot_;
+	GeneratorType type_;
+	double timestep_;
+	Generator::Resolution resolution_;
+	WarmStart warm_start_;
+};
@@ -0,0 +1,185 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "GenerationMetrics.h"
+#include "PathGroup.h"
+#include <QtCore/QJsonArray>
+#include <algorithm>
+#include <cmath>
+
+GenerationMetrics::GenerationMetrics(int window)
+{
+	window_ = (window < 1) ? 1 : window;
+	total_ = 0;
+	failed_ = 0;
+}
+
+void GenerationMetrics::record(std::shared_ptr<TrajectoryGroup> group)
+{
+	Job job;
+
+	job.path = group->path()->fullname();
+	job.type = group->type();
+	job.queued = group->queueTime();
+	job.wall = group->generationTime();
+	job.iterations = group->stats().iterations();
+	job.percent = group->stats().finalPercent();
+	job.success = !group->hasError();
+	job.error = group->errorMessage();
+	job.estimated = group->hasResolutionError();
+	job.resolution = group->resolutionError();
+	job.units = group->snapshot()->units();
+
+	QMutexLocker lock(&lock_);
+	jobs_.push_back(job);
+	while (jobs_.size() > window_) {
+		jobs_.pop_front();
+	}
+
+	total_++;
+	if (!job.success) {
+		failed_++;
+	}
+}
+
+void GenerationMetrics::clear()
+{
+	QMutexLocker lock(&lock_);
+	jobs_.clear();
+	total_ = 0;
+	failed_ = 0;
+}
+
+QVector<GenerationMetrics::Job> GenerationMetrics::jobs() const
+{
+	QMutexLocker lock(&lock_);
+	return QVector<Job>(jobs_.begin(), jobs_.end());
+}
+
+int GenerationMetrics::totalJobs() const
+{
+	QMutexLocker lock(&lock_);
+	return total_;
+}
+
+int GenerationMetrics::totalFailed() const
+{
+	QMutexLocker lock(&lock_);
+	return failed_;
+}
+
+GenerationMetrics::Summary GenerationMetrics::queued() const
+{
+	return summarize(Field::Queued);
+}
+
+GenerationMetrics::Summary GenerationMetrics::wall() const
+{
+	return summarize(Field::Wall);
+}
+
+GenerationMetrics::Summary GenerationMetrics::iterations() const
+{
+	return summarize(Field::Iterations);
+}
+
+GenerationMetrics::Summary GenerationMetrics::summarize(Field field) const
+{
+	QVector<double> samples;
+
+	lock_.lock();
+	for (const Job& job : jobs_) {
+		switch (field) {
+		case Field::Queued:
+			samples.push_back(job.queued);
+			break;
+		case Field::Wall:
+			samples.push_back(job.wall);
+			break;
+		case Field::Iterations:
+			samples.push_back(job.iterations);
+			break;
+		}
+	}
+	lock_.unlock();
+
+	Summary ret;
+	ret.p50 = percentile(samples, 50.0);
+	ret.p95 = percentile(samples, 95.0);
+	ret.max = percentile(samples, 100.0);
+	return ret;
+}
+
+double GenerationMetrics::percentile(QVector<double> samples, double pct)
+{
+	if (samples.size() == 0)
+		return 0.0;
+
+	std::sort(samples.begin(), samples.end());
+
+	int rank = static_cast<int>(std::ceil(pct / 100.0 * samples.size()));
+	rank = std::clamp(rank, 1, static_cast<int>(samples.size()));
+	return samples[rank - 1];
+}
+
+QJsonObject GenerationMetrics::toJSON(const Summary& summary)
+{
+	QJsonObject obj;
+	obj["p50"] = summary.p50;
+	obj["p95"] = summary.p95;
+	obj["max"] = summary.max;
+	return obj;
+}
+
+QJsonObject GenerationMetrics::toJSON(int pending, int active) const
+{
+	QJsonArray list;
+
+	for (const Job& job : jobs()) {
+		QJsonObject obj;
+		obj["path"] = job.path;
+		obj["generator"] = typeToKey(job.type);
+		obj["queued"] = job.queued;
+		obj["wall"] = job.wall;
+		obj["iterations"] = job.iterations;
+		obj["percent"] = job.percent;
+		obj["success"] = job.success;
+		if (job.error.length() > 0) {
+			obj["error"] = job.error;
+		}
+		if (job.estimated) {
+			QJsonObject res;
+			res["position"] = job.resolution.position;
+			res["velocity"] = job.resolution.velocity;
+			res["duration"] = job.resolution.duration;
+			res["units"] = job.units;
+			obj["resolutionerror"] = res;
+		}
+		list.append(obj);
+	}
+
+	QJsonObject ret;
+	ret["total"] = totalJobs();
+	ret["failed"] = totalFailed();
+	ret["pending"] = pending;
+	ret["active"] = active;
+	ret["queued"] = toJSON(queued());
+	ret["wall"] = toJSON(wall());
+	ret["iterations"] = toJSON(iterations());
+	ret["jobs"] = list;
+
+	return ret;
+}
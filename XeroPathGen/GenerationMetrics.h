@@ -0,0 +1,105 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include "GeneratorType.h"
+#include "TrajectoryGroup.h"
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <memory>
+
+//
+// Records what happened to each path the generation manager ran.  The most recent
+// jobs are kept so that the summaries follow the current editing session rather
+// than everything since the program started.
+//
+class GenerationMetrics
+{
+public:
+	struct Job
+	{
+		QString path;
+		GeneratorType type;
+		double queued;					// Seconds waiting in the queue
+		double wall;					// Seconds generating
+		int iterations;
+		double percent;
+		bool success;
+		QString error;
+		bool estimated;					// If true, the resolution error was estimated
+		TrajectoryGroup::ResolutionError resolution;
+		QString units;					// The units of the resolution error
+	};
+
+	struct Summary
+	{
+		double p50;
+		double p95;
+		double max;
+	};
+
+	static constexpr int DefaultWindow = 200;
+
+public:
+	GenerationMetrics(int window = DefaultWindow);
+
+	void record(std::shared_ptr<TrajectoryGroup> group);
+	void clear();
+
+	//
+	// The jobs in the window, oldest first
+	//
+	QVector<Job> jobs() const;
+
+	//
+	// Counts since the program started or the metrics were cleared
+	//
+	int totalJobs() const;
+	int totalFailed() const;
+
+	Summary queued() const;
+	Summary wall() const;
+	Summary iterations() const;
+
+	QJsonObject toJSON(int pending, int active) const;
+
+	//
+	// Returns the percentile (0 - 100) of a set of samples using the nearest rank
+	//
+	static double percentile(QVector<double> samples, double pct);
+
+private:
+	enum class Field
+	{
+		Queued,
+		Wall,
+		Iterations
+	};
+
+	Summary summarize(Field field) const;
+	static QJsonObject toJSON(const Summary& summary);
+
+private:
+	mutable QMutex lock_;
+	QList<Job> jobs_;
+	int window_;
+	int total_;
+	int failed_;
+};
@@ -0,0 +1,163 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "GenerationMetricsWindow.h"
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtGui/QFont>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+
+GenerationMetricsWindow::GenerationMetricsWindow(GenerationMgr& mgr, QWidget* parent) : QWidget(parent), mgr_(mgr)
+{
+	shown_ = -1;
+
+	QVBoxLayout* layout = new QVBoxLayout();
+	setLayout(layout);
+
+	queue_ = new QLabel();
+	layout->addWidget(queue_);
+
+	memory_ = new QLabel();
+	layout->addWidget(memory_);
+
+	summary_ = new QLabel();
+	summary_->setTextFormat(Qt::PlainText);
+	QFont font("Monospace");
+	font.setStyleHint(QFont::TypeWriter);
+	summary_->setFont(font);
+	layout->addWidget(summary_);
+
+	jobs_ = new QTreeWidget();
+	jobs_->setRootIsDecorated(false);
+	jobs_->setHeaderLabels({ "Path", "Generator", "Queued (ms)", "Wall (ms)", "Iterations", "Percent", "Position Error", "Velocity Error", "Result" });
+	layout->addWidget(jobs_);
+
+	QHBoxLayout* buttons = new QHBoxLayout();
+	layout->addLayout(buttons);
+	buttons->addStretch();
+
+	export_ = new QPushButton(tr("Export JSON ..."));
+	buttons->addWidget(export_);
+	(void)connect(export_, &QPushButton::clicked, this, &GenerationMetricsWindow::exportJSON);
+
+	clear_ = new QPushButton(tr("Clear"));
+	buttons->addWidget(clear_);
+	(void)connect(clear_, &QPushButton::clicked, this, &GenerationMetricsWindow::clearMetrics);
+
+	//
+	// The queue depth changes without a path finishing, so it is polled while the window is shown
+	//
+	timer_ = new QTimer(this);
+	timer_->setInterval(250);
+	(void)connect(timer_, &QTimer::timeout, this, &GenerationMetricsWindow::updateQueue);
+	timer_->start();
+
+	refresh();
+}
+
+void GenerationMetricsWindow::showEvent(QShowEvent*)
+{
+	refresh();
+}
+
+void GenerationMetricsWindow::updateQueue()
+{
+	if (!isVisible())
+		return;
+
+	queue_->setText("Queue: " + QString::number(mgr_.pendingCount()) + " pending, " + QString::number(mgr_.activeCount()) +
+		" generating on " + QString::number(mgr_.threadCount()) + " threads");
+
+	QString budget = (mgr_.trajectoryBudget() > 0) ? QString::number(mgr_.trajectoryBudget() / 1048576.0, 'f', 0) + " MB" : "unlimited";
+	memory_->setText("Trajectories: " + QString::number(mgr_.trajectoryCount()) + " paths using " +
+		QString::number(mgr_.trajectoryMemoryUsage() / 1048576.0, 'f', 1) + " MB of " + budget + ", " +
+		QString::number(mgr_.trajectoryEvictions()) + " dropped");
+
+	if (mgr_.metrics().totalJobs() != shown_)
+		refresh();
+}
+
+QString GenerationMetricsWindow::formatSummary(const QString& name, const GenerationMetrics::Summary& summary, bool time)
+{
+	double scale = time ? 1000.0 : 1.0;
+	int digits = time ? 1 : 0;
+
+	return name.leftJustified(12) +
+		"p50 " + QString::number(summary.p50 * scale, 'f', digits).rightJustified(9) +
+		"   p95 " + QString::number(summary.p95 * scale, 'f', digits).rightJustified(9) +
+		"   max " + QString::number(summary.max * scale, 'f', digits).rightJustified(9);
+}
+
+void GenerationMetricsWindow::refresh()
+{
+	GenerationMetrics& metrics = mgr_.metrics();
+	auto jobs = metrics.jobs();
+
+	shown_ = metrics.totalJobs();
+
+	QString text;
+	text += QString::number(metrics.totalJobs()) + " paths generated, " + QString::number(metrics.totalFailed()) + " failed, last " +
+		QString::number(jobs.size()) + " shown\n";
+	text += formatSummary("queued ms", metrics.queued(), true) + "\n";
+	text += formatSummary("wall ms", metrics.wall(), true) + "\n";
+	text += formatSummary("iterations", metrics.iterations(), false);
+	summary_->setText(text);
+
+	jobs_->clear();
+	for (int i = jobs.size() - 1; i >= 0; i--) {
+		const GenerationMetrics::Job& job = jobs[i];
+
+		QTreeWidgetItem* item = new QTreeWidgetItem();
+		item->setText(0, job.path);
+		item->setText(1, typeToKey(job.type));
+		item->setText(2, QString::number(job.queued * 1000.0, 'f', 1));
+		item->setText(3, QString::number(job.wall * 1000.0, 'f', 1));
+		item->setText(4, QString::number(job.iterations));
+		item->setText(5, QString::number(job.percent * 100.0, 'f', 0));
+		if (job.estimated) {
+			item->setText(6, QString::number(job.resolution.position, 'g', 3) + " " + job.units);
+			item->setText(7, QString::number(job.resolution.velocity, 'g', 3) + " " + job.units + "/s");
+		}
+		item->setText(8, job.success ? "ok" : job.error);
+		jobs_->addTopLevelItem(item);
+	}
+
+	updateQueue();
+}
+
+void GenerationMetricsWindow::clearMetrics()
+{
+	mgr_.metrics().clear();
+	refresh();
+}
+
+void GenerationMetricsWindow::exportJSON()
+{
+	QString filename = QFileDialog::getSaveFileName(this, tr("Export Generation Metrics"), "", tr("JSON File (*.json);;All Files (*)"));
+	if (filename.length() == 0)
+		return;
+
+	QFile file(filename);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		QMessageBox::critical(this, "Export Failed", "Cannot open file '" + filename + "' for writing");
+		return;
+	}
+
+	QJsonDocument doc(mgr_.metrics().toJSON(mgr_.pendingCount(), mgr_.activeCount()));
+	file.write(doc.toJson());
+	file.close();
+}
@@ -0,0 +1,54 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include "GenerationMgr.h"
+#include <QtCore/QTimer>
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QTreeWidget>
+
+class GenerationMetricsWindow : public QWidget
+{
+public:
+	GenerationMetricsWindow(GenerationMgr& mgr, QWidget* parent);
+
+	void refresh();
+
+protected:
+	void showEvent(QShowEvent*) override;
+
+private:
+	void exportJSON();
+	void clearMetrics();
+	void updateQueue();
+
+	static QString formatSummary(const QString& name, const GenerationMetrics::Summary& summary, bool time);
+
+private:
+	GenerationMgr& mgr_;
+	QTimer* timer_;
+	QLabel* queue_;
+	QLabel* memory_;
+	QLabel* summary_;
+	QTreeWidget* jobs_;
+	QPushButton* export_;
+	QPushButton* clear_;
+	int shown_;
+};
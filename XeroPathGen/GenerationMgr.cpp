@@ -17,15 +17,26 @@
 #include "Generator.h"
 #include "RobotPath.h"
 #include "PathGroup.h"
+#include "Tracer.h"
+#include "TrajectoryUtils.h"
+#include "UnitConverter.h"
 #include <QtCore/QStandardPaths>
 #include <QtCore/QFile>
 
 GenerationMgr::GenerationMgr()
 {
-	worker_ = nullptr;
-	thread_ = nullptr;
-	active_type_ = GeneratorType::CheesyPoofs;
 	timestep_ = 0.02;
+	publish_progress_ = false;
+	preset_ = ResolutionPreset::Standard;
+	adaptive_ = false;
+	estimate_error_ = false;
+	selected_ = nullptr;
+	sequence_ = 0;
+	batch_sequence_ = 0;
+	thread_count_ = QThread::idealThreadCount();
+	if (thread_count_ < 1) {
+		thread_count_ = 1;
+	}
 
 	QStringList dirs = QStandardPaths::standardLocations(QStandardPaths::AppLocalDataLocation);
 	logfile_ = dirs.front() + "/generators_log.txt";
@@ -42,92 +53,492 @@ void GenerationMgr::clear()
 	pending_queue_.clear();
 	pending_queue_mutex_.unlock();
 
-	if (thread_ != nullptr) {
-		thread_->terminate();
-		thread_ = nullptr;
-		worker_ = nullptr;
+	active_queue_mutex_.lock();
+	for (auto active : active_.values()) {
+		active.first->terminate();
+	}
+	active_.clear();
+	active_queue_mutex_.unlock();
+
+	//
+	// The paths the batches are waiting for will never complete
+	//
+	QList<std::weak_ptr<GenerationBatch>> batches = batches_;
+	batches_.clear();
+	for (auto weak : batches) {
+		auto batch = weak.lock();
+		if (batch != nullptr) {
+			batch->cancel();
+		}
+	}
+}
+
+RobotParams::Fields GenerationMgr::setRobot(std::shared_ptr<RobotParams> robot)
+{
+	RobotParams::Fields changed = RobotParams::AllFields;
+
+	if (robot == nullptr) {
+		robot_ = nullptr;
+	}
+	else {
+		if (robot_ != nullptr) {
+			changed = robot->changedFields(*robot_);
+		}
+		robot_ = std::make_shared<RobotParams>(*robot);
 	}
+
+	return changed;
 }
 
 std::shared_ptr<TrajectoryGroup> GenerationMgr::getTrajectoryGroup(std::shared_ptr<RobotPath> path)
 {
 	std::shared_ptr<TrajectoryGroup> ret;
+	GeneratorType type;
+	bool evicted = false;
 
 	trajectory_group_mutex_.lock();
-	if (trajectories_.contains(path)) {
-		ret = trajectories_.value(path);
+	ret = trajectories_.get(path);
+	if (ret == nullptr) {
+		evicted = trajectories_.takeEvicted(path, type);
 	}
 	trajectory_group_mutex_.unlock();
 
+	//
+	// A group dropped to stay within the memory budget is generated again, and
+	// generationComplete() is emitted when it is ready
+	//
+	if (evicted) {
+		addPath(type, path);
+	}
+
 	return ret;
 }
 
-void GenerationMgr::addPath(GeneratorType type, std::shared_ptr<RobotPath> path)
+void GenerationMgr::addPath(GeneratorType type, std::shared_ptr<RobotPath> path, bool preview, Priority priority)
+{
+	queuePath(type, path, preview, priority, 0);
+}
+
+void GenerationMgr::queuePath(GeneratorType type, std::shared_ptr<RobotPath> path, bool preview, Priority priority, quint64 batch)
 {
 	if (robot_ != nullptr) {
-		removePath(path);
+		Request req;
+		req.type = type;
+		req.path = path;
+		req.preview = preview;
+		req.changed = path->takeChangedAt();
+
+		//
+		// The path is copied here, on the thread that edits it, so the generator
+		// never reads a path that is being changed
+		//
+		req.snapshot = path->snapshot();
+
 		pending_queue_mutex_.lock();
-		pending_queue_.push_back(QPair<GeneratorType, std::shared_ptr<RobotPath>>(type, path));
+
+		//
+		// A request still waiting for the path is replaced.  The new request keeps the
+		// place in line and the higher priority of the two, and the edit time of the old
+		// one so latency is measured from the first edit the new result includes.  The
+		// merged request belongs to no batch, so canceling a batch leaves it queued.
+		//
+		auto it = pending_queue_.find(path.get());
+		if (it != pending_queue_.end()) {
+			if (it->changed != 0) {
+				req.changed = it->changed;
+			}
+			if (it->requested < priority) {
+				priority = it->requested;
+			}
+			req.sequence = it->sequence;
+			req.batch = 0;
+		}
+		else {
+			req.sequence = sequence_++;
+			req.batch = batch;
+		}
+
+		//
+		// The selected path goes first, and keeps the priority it was requested with
+		// for when it is no longer selected
+		//
+		req.requested = priority;
+		req.priority = (path.get() == selected_) ? Priority::Selected : priority;
+		req.queued = Tracer::now();
+		pending_queue_.insert(path.get(), req);
 		pending_queue_mutex_.unlock();
+
 		schedulePath();
 	}
 }
 
-void GenerationMgr::removePath(std::shared_ptr<RobotPath> path)
+std::shared_ptr<GenerationBatch> GenerationMgr::addPaths(GeneratorType type, const QVector<std::shared_ptr<RobotPath>>& paths, Priority priority)
+{
+	auto batch = std::make_shared<GenerationBatch>(*this, paths);
+	batch->id_ = ++batch_sequence_;
+
+	if (robot_ == nullptr) {
+		batch->cancel();
+	}
+	else {
+		batches_.push_back(batch);
+		for (auto path : paths) {
+			queuePath(type, path, false, priority, batch->id_);
+		}
+	}
+
+	return batch;
+}
+
+std::shared_ptr<GenerationBatch> GenerationMgr::updatePaths(GeneratorType type, const QVector<std::shared_ptr<RobotPath>>& paths, RobotParams::Fields changed, Priority priority)
 {
+	auto batch = std::make_shared<GenerationBatch>(*this, paths);
+	batch->id_ = ++batch_sequence_;
+
+	if (robot_ == nullptr) {
+		batch->cancel();
+		return batch;
+	}
+
+	batches_.push_back(batch);
+
+	bool tank = (robot_->getDriveType() == RobotParams::DriveType::TankDrive);
+	RobotParams::Fields sides = RobotParams::WheelBaseWidthField | RobotParams::LengthUnitsField;
+
+	for (auto path : paths) {
+		auto group = reusableGroup(type, path);
+		if (group == nullptr || (group->robotFields() & changed) != 0) {
+			queuePath(type, path, false, priority, batch->id_);
+			continue;
+		}
+
+		if (tank && (changed & sides) != 0 && !group->hasError()) {
+			//
+			// The left and right trajectories are offset from the main trajectory by the
+			// wheelbase width.  The new group is a copy, so a batch holding the old one
+			// still sees trajectories that agree with each other.  It is not an edit, so
+			// it is left out of the edit latency.
+			//
+			group = std::make_shared<TrajectoryGroup>(*group);
+			group->setTimestamp(TrajectoryGroup::Event::Changed, 0);
+			double width = UnitConverter::convert(robot_->getWheelBaseWidth(), robot_->getLengthUnits(), group->snapshot()->units());
+			TrajectoryUtils::addTankDriveTrajectories(*group, width);
+
+			trajectory_group_mutex_.lock();
+			trajectories_.insert(path, group);
+			trajectory_group_mutex_.unlock();
+
+			emit generationComplete(path);
+		}
+
+		batch->addGroup(group);
+	}
+
+	return batch;
+}
+
+//
+// The stored group for a path if it is a complete, full fidelity generation of the
+// path as it is now, otherwise nullptr
+//
+std::shared_ptr<TrajectoryGroup> GenerationMgr::reusableGroup(GeneratorType type, std::shared_ptr<RobotPath> path)
+{
+	if (path->changedAt() != 0) {
+		return nullptr;
+	}
+
 	pending_queue_mutex_.lock();
+	bool pending = pending_queue_.contains(path.get());
+	pending_queue_mutex_.unlock();
 
-	auto it = std::find_if(pending_queue_.begin(), pending_queue_.end(), 
-		[&path](QPair<GeneratorType, std::shared_ptr<RobotPath>> pair) { return pair.second == path; });
+	active_queue_mutex_.lock();
+	bool active = active_.contains(path);
+	active_queue_mutex_.unlock();
 
-	if (it != pending_queue_.end()) {
-		pending_queue_.erase(it);
+	if (pending || active) {
+		return nullptr;
 	}
 
+	trajectory_group_mutex_.lock();
+	auto group = trajectories_.get(path);
+	trajectory_group_mutex_.unlock();
+
+	if (group == nullptr || group->type() != type || group->isPreview() || group->isInterim()) {
+		return nullptr;
+	}
+
+	return group;
+}
+
+void GenerationMgr::convertPaths(const QVector<std::shared_ptr<RobotPath>>& paths)
+{
+	for (auto path : paths) {
+		pending_queue_mutex_.lock();
+		auto it = pending_queue_.find(path.get());
+		if (it != pending_queue_.end()) {
+			it->snapshot = path->snapshot();
+		}
+		pending_queue_mutex_.unlock();
+
+		trajectory_group_mutex_.lock();
+		auto group = trajectories_.get(path);
+		trajectory_group_mutex_.unlock();
+
+		if (group == nullptr) {
+			continue;
+		}
+
+		//
+		// The stored group has been shown already, so converting it is not an edit
+		// and is left out of the edit latency
+		//
+		auto converted = convertGroup(group);
+		if (converted != group) {
+			converted->setTimestamp(TrajectoryGroup::Event::Changed, 0);
+
+			trajectory_group_mutex_.lock();
+			trajectories_.insert(path, converted);
+			trajectory_group_mutex_.unlock();
+		}
+	}
+}
+
+//
+// A group generated before its path changed units is converted to the units of the path
+//
+std::shared_ptr<TrajectoryGroup> GenerationMgr::convertGroup(std::shared_ptr<TrajectoryGroup> group)
+{
+	if (group->snapshot()->units() == group->path()->units()) {
+		return group;
+	}
+
+	return group->convert(group->path()->units());
+}
+
+void GenerationMgr::removePath(std::shared_ptr<RobotPath> path)
+{
+	cancelPath(path);
+
+	trajectory_group_mutex_.lock();
+	trajectories_.remove(path);
+	trajectory_group_mutex_.unlock();
+}
+
+void GenerationMgr::cancelPath(std::shared_ptr<RobotPath> path)
+{
+	pending_queue_mutex_.lock();
+	bool removed = (pending_queue_.remove(path.get()) > 0);
 	pending_queue_mutex_.unlock();
+
+	if (removed) {
+		for (auto weak : QList<std::weak_ptr<GenerationBatch>>(batches_)) {
+			auto batch = weak.lock();
+			if (batch != nullptr) {
+				batch->pathRemoved(path);
+			}
+		}
+	}
+}
+
+void GenerationMgr::cancelBatch(quint64 batch)
+{
+	QMutexLocker lock(&pending_queue_mutex_);
+
+	auto it = pending_queue_.begin();
+	while (it != pending_queue_.end()) {
+		if (it->batch != batch) {
+			++it;
+			continue;
+		}
+
+		//
+		// An edit the request included goes back to the path, so the group generated
+		// before the edit is not reused as if the path were unchanged
+		//
+		if (it->changed != 0) {
+			it->path->restoreChangedAt(it->changed);
+		}
+		it = pending_queue_.erase(it);
+	}
+}
+
+void GenerationMgr::setSelectedPath(std::shared_ptr<RobotPath> path)
+{
+	QMutexLocker lock(&pending_queue_mutex_);
+
+	//
+	// The path that was selected goes back to the priority it was requested with
+	//
+	if (selected_ != nullptr && pending_queue_.contains(selected_)) {
+		pending_queue_[selected_].priority = pending_queue_[selected_].requested;
+	}
+
+	selected_ = path.get();
+	if (selected_ != nullptr && pending_queue_.contains(selected_)) {
+		pending_queue_[selected_].priority = Priority::Selected;
+	}
 }
 
 void GenerationMgr::schedulePath()
 {
+	Tracer::Span span(Tracer::QueueCategory, "schedule");
+
 	pending_queue_mutex_.lock();
 	active_queue_mutex_.lock();
 
-	if (pending_queue_.size() > 0 && worker_ == nullptr && thread_ == nullptr) {
-		GeneratorType type = pending_queue_.front().first;
-		std::shared_ptr<RobotPath> path = pending_queue_.front().second;
+	while (active_.size() < thread_count_) {
+		//
+		// Start the waiting path with the highest priority that was requested first.  A
+		// path that is still being generated stays waiting until the older generation
+		// finishes, so that an old result can never replace a newer one.
+		//
+		auto next = pending_queue_.end();
+		for (auto it = pending_queue_.begin(); it != pending_queue_.end(); ++it) {
+			if (active_.contains(it->path)) {
+				continue;
+			}
 
-		pending_queue_.pop_front();
-		pending_queue_mutex_.unlock();
+			if (next == pending_queue_.end() || it->priority < next->priority ||
+				(it->priority == next->priority && it->sequence < next->sequence)) {
+				next = it;
+			}
+		}
 
-		auto trajgrp = std::make_shared<TrajectoryGroup>(type, path);
+		if (next == pending_queue_.end()) {
+			break;
+		}
 
-		thread_ = new QThread();
-		worker_ = new Generator(logfile_, loglock_, timestep_, robot_, trajgrp);
-		worker_->moveToThread(thread_);
+		Request req = next.value();
+		pending_queue_.erase(next);
+		std::shared_ptr<RobotPath> path = req.path;
 
-		connect(thread_, &QThread::started, worker_, &Generator::generateTrajectory);
-		connect(thread_, &QThread::finished, worker_, &QObject::deleteLater);
+		qint64 now = Tracer::now();
+		Tracer::addSpan(Tracer::QueueCategory, "queued", Tracer::pathName(path.get()), req.queued, now);
 
-		connect(worker_, &Generator::trajectoryComplete, this, &GenerationMgr::pathFinished);
-		connect(worker_, &Generator::trajectoryComplete, thread_, &QThread::quit);
-		connect(worker_, &Generator::trajectoryComplete, worker_, &QObject::deleteLater);
+		auto trajgrp = std::make_shared<TrajectoryGroup>(req.type, path);
+		trajgrp->setSnapshot(req.snapshot);
+		trajgrp->setPreview(req.preview);
+		trajgrp->setQueueTime((now - req.queued) / 1.0e9);
+		trajgrp->setTimestamp(TrajectoryGroup::Event::Changed, req.changed);
+		trajgrp->setTimestamp(TrajectoryGroup::Event::Queued, req.queued);
 
-		thread_->start();
-	}
-	else {
-		pending_queue_mutex_.unlock();
+		QThread* thread = new QThread();
+		//
+		// Each generation reads its own copy of the robot, which records the parameters
+		// the generation depends on
+		//
+		auto robot = std::make_shared<RobotParams>(*robot_);
+		robot->clearFieldsRead();
+
+		Generator* worker = new Generator(logfile_, loglock_, timestep_, robot, trajgrp);
+		worker->setPublishProgress(publish_progress_);
+		worker->setResolutionPreset(preset_, adaptive_);
+		worker->setEstimateError(estimate_error_);
+
+		//
+		// The swerve search starts from where the last generation of the path ended
+		//
+		trajectory_group_mutex_.lock();
+		auto previous = trajectories_.get(path);
+		trajectory_group_mutex_.unlock();
+		if (previous != nullptr) {
+			worker->setWarmStart(previous->warmStart());
+		}
+		worker->moveToThread(thread);
+
+		connect(thread, &QThread::started, worker, &Generator::generateTrajectory);
+		connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+		connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+		connect(worker, &Generator::trajectoryProgress, this, &GenerationMgr::pathProgress);
+		connect(worker, &Generator::trajectoryComplete, this, &GenerationMgr::pathFinished);
+		connect(worker, &Generator::trajectoryComplete, thread, &QThread::quit);
+
+		active_.insert(path, QPair<QThread*, std::shared_ptr<TrajectoryGroup>>(thread, trajgrp));
+		thread->start();
 	}
+
+	pending_queue_mutex_.unlock();
 	active_queue_mutex_.unlock();
 }
 
+void GenerationMgr::pathProgress(std::shared_ptr<TrajectoryGroup> interim)
+{
+	//
+	// Each generation works from its own snapshot, so an interim result is only shown
+	// if the generation it came from is still the one running for the path
+	//
+	active_queue_mutex_.lock();
+	bool current = active_.contains(interim->path()) && active_.value(interim->path()).second->snapshot() == interim->snapshot();
+	active_queue_mutex_.unlock();
+
+	if (!current) {
+		return;
+	}
+
+	interim = convertGroup(interim);
+
+	trajectory_group_mutex_.lock();
+	trajectories_.insert(interim->path(), interim);
+	trajectory_group_mutex_.unlock();
+
+	emit generationProgress(interim->path());
+}
+
 void GenerationMgr::pathFinished(std::shared_ptr<TrajectoryGroup> group)
 {
+	//
+	// A result for a generation that was cleared after it finished, but before this
+	// signal was delivered, is stale and is dropped
+	//
 	active_queue_mutex_.lock();
-	thread_ = nullptr;
-	worker_ = nullptr;
-	trajectories_.insert(group->path(), group);
+	bool current = active_.contains(group->path()) && active_.value(group->path()).second == group;
+	if (current) {
+		active_.remove(group->path());
+	}
 	active_queue_mutex_.unlock();
+
+	if (!current) {
+		return;
+	}
+
+	group = convertGroup(group);
+
+	trajectory_group_mutex_.lock();
+	trajectories_.insert(group->path(), group);
+	trajectory_group_mutex_.unlock();
+
+	group->setTimestamp(TrajectoryGroup::Event::Delivered, Tracer::now());
+
+	//
+	// Previews are left out of the metrics so they describe full generations only
+	//
+	if (!group->isPreview()) {
+		metrics_.record(group);
+	}
+
 	schedulePath();
 
 	emit generationComplete(group->path());
+
+	//
+	// Previews do not count towards a batch, the full generation that follows does
+	//
+	if (!group->isPreview()) {
+		QList<std::weak_ptr<GenerationBatch>> batches;
+		for (auto weak : batches_) {
+			auto batch = weak.lock();
+			if (batch != nullptr && !batch->isFinished()) {
+				batches.push_back(weak);
+			}
+		}
+		batches_ = batches;
+
+		for (auto weak : batches) {
+			auto batch = weak.lock();
+			if (batch != nullptr) {
+				batch->pathFinished(group);
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -20,14 +20,30 @@
 #include "Generator.h"
 #include "TrajectoryGroup.h"
 #include "RobotParams.h"
+#include "GenerationMetrics.h"
+#include "GenerationBatch.h"
+#include "TrajectoryStore.h"
 #include <QtCore/QObject>
 #include <QtCore/QMutex>
 #include <QtCore/QThread>
+#include <QtCore/QHash>
 
 class GenerationMgr : public QObject
 {
 	Q_OBJECT
 
+public:
+	//
+	// The order paths waiting to be generated are started in.  Within a priority paths
+	// are started in the order they were first requested.
+	//
+	enum class Priority : int
+	{
+		Selected,						// The path the user is looking at
+		Edited,							// A path that was just changed
+		Background,						// Any other path, e.g. every path after the robot changes
+	};
+
 public:
 	GenerationMgr();
 
@@ -39,19 +55,135 @@ public:
 		return timestep_;
 	}
 
-	void setRobot(std::shared_ptr<RobotParams> robot) {
-		robot_ = robot;
+	//
+	// The number of paths that may be generated at the same time, each on its own thread
+	//
+	void setThreadCount(int count) {
+		thread_count_ = (count < 1) ? 1 : count;
+		schedulePath();
+	}
+
+	int threadCount() const {
+		return thread_count_;
+	}
+
+	//
+	// Sets the robot the paths are generated for.  The robot is copied, so a robot that
+	// is edited must be set again.  Returns the robot parameters that differ from the
+	// robot set before, all of them if there was none.
+	//
+	RobotParams::Fields setRobot(std::shared_ptr<RobotParams> robot);
+
+	//
+	// When enabled, paths that take several iterations to generate publish their
+	// intermediate trajectories with generationProgress() before they complete
+	//
+	void setPublishProgress(bool publish) {
+		publish_progress_ = publish;
+	}
+
+	//
+	// The resolution full generations use.  The stored trajectories are not changed,
+	// the paths must be generated again.
+	//
+	void setResolution(ResolutionPreset preset, bool adaptive) {
+		preset_ = preset;
+		adaptive_ = adaptive;
+	}
+
+	ResolutionPreset resolutionPreset() const {
+		return preset_;
 	}
 
-	void addPath(GeneratorType type, std::shared_ptr<RobotPath> path);
+	bool isAdaptive() const {
+		return adaptive_;
+	}
+
+	//
+	// When enabled, the error of each full generation is estimated against a generation
+	// at the reference resolution, see TrajectoryGroup::resolutionError()
+	//
+	void setEstimateError(bool estimate) {
+		estimate_error_ = estimate;
+	}
+
+	bool estimateError() const {
+		return estimate_error_;
+	}
+
+	//
+	// A preview generation is a quick, low fidelity generation used while a path is
+	// being dragged.  Its result replaces the displayed trajectory until a full
+	// generation of the path is requested.
+	//
+	void addPath(GeneratorType type, std::shared_ptr<RobotPath> path, bool preview = false, Priority priority = Priority::Edited);
+	//
+	// Removes a path that was deleted, both from the queue and its generated trajectories
+	//
 	void removePath(std::shared_ptr<RobotPath> path);
 
+	//
+	// Removes a path from the queue if it has not started generating, and counts it as
+	// failed in every batch waiting for it
+	//
+	void cancelPath(std::shared_ptr<RobotPath> path);
+
+	//
+	// Removes the requests that were made by the given batch alone and have not started
+	// generating.  A request merged with any other request is left in the queue.
+	//
+	void cancelBatch(quint64 batch);
+
+	//
+	// Queues a set of paths and returns a batch that tracks them until all have been
+	// generated.  If there is no robot the batch is returned already canceled.
+	//
+	std::shared_ptr<GenerationBatch> addPaths(GeneratorType type, const QVector<std::shared_ptr<RobotPath>>& paths, Priority priority = Priority::Background);
+
+	//
+	// Like addPaths(), after the robot parameters given have changed.  A path whose
+	// trajectories did not read any of them keeps its trajectories and completes in the
+	// batch right away.  A tank drive path that depends on them only through its left
+	// and right trajectories has just those computed again.
+	//
+	std::shared_ptr<GenerationBatch> updatePaths(GeneratorType type, const QVector<std::shared_ptr<RobotPath>>& paths, RobotParams::Fields changed, Priority priority = Priority::Background);
+
+	//
+	// Called after the units of paths have changed.  The stored trajectories and the
+	// requests waiting to be generated are converted to the new units, and results
+	// that are still being generated are converted as they complete, so no path is
+	// generated again.
+	//
+	void convertPaths(const QVector<std::shared_ptr<RobotPath>>& paths);
+
+	//
+	// The selected path is always generated first.  If it is already waiting it moves
+	// ahead of every other path.
+	//
+	void setSelectedPath(std::shared_ptr<RobotPath> path);
+
 	std::shared_ptr<TrajectoryGroup> getTrajectoryGroup(std::shared_ptr<RobotPath> path);
 
+	int pendingCount() {
+		QMutexLocker lock(&pending_queue_mutex_);
+		return pending_queue_.size();
+	}
+
+	int activeCount() {
+		QMutexLocker lock(&active_queue_mutex_);
+		return active_.size();
+	}
+
+	GenerationMetrics& metrics() {
+		return metrics_;
+	}
+
 	bool isEmpty() {
 		bool ret = true;
 		pending_queue_mutex_.lock();
-		ret = pending_queue_.size() == 0 && worker_ == nullptr;
+		active_queue_mutex_.lock();
+		ret = pending_queue_.size() == 0 && active_.size() == 0;
+		active_queue_mutex_.unlock();
 		pending_queue_mutex_.unlock();
 		return ret;
 	}
@@ -64,30 +196,91 @@ public:
 		trajectory_group_mutex_.unlock();
 	}
 
+	//
+	// The most memory, in bytes, the generated trajectories may hold, zero for no limit.
+	// The least recently used groups beyond it are dropped and are regenerated the next
+	// time they are asked for with getTrajectoryGroup().
+	//
+	void setTrajectoryBudget(qint64 bytes) {
+		QMutexLocker lock(&trajectory_group_mutex_);
+		trajectories_.setBudget(bytes);
+	}
+
+	qint64 trajectoryBudget() {
+		QMutexLocker lock(&trajectory_group_mutex_);
+		return trajectories_.budget();
+	}
+
+	qint64 trajectoryMemoryUsage() {
+		QMutexLocker lock(&trajectory_group_mutex_);
+		return trajectories_.memoryUsage();
+	}
+
+	int trajectoryCount() {
+		QMutexLocker lock(&trajectory_group_mutex_);
+		return trajectories_.count();
+	}
+
+	int trajectoryEvictions() {
+		QMutexLocker lock(&trajectory_group_mutex_);
+		return trajectories_.evictions();
+	}
+
 signals:
+	void generationProgress(std::shared_ptr<RobotPath> path);
 	void generationComplete(std::shared_ptr<RobotPath> path);
 
 private:
 	void schedulePath();
+	std::shared_ptr<TrajectoryGroup> reusableGroup(GeneratorType type, std::shared_ptr<RobotPath> path);
+	std::shared_ptr<TrajectoryGroup> convertGroup(std::shared_ptr<TrajectoryGroup> group);
+	void pathProgress(std::shared_ptr<TrajectoryGroup> interim);
 	void pathFinished(std::shared_ptr<TrajectoryGroup> path);
 
+private:
+	//
+	// A path waiting to be generated
+	//
+	struct Request
+	{
+		GeneratorType type;							// The generator to use
+		std::shared_ptr<RobotPath> path;			// The path being edited, used as the key for the results
+		std::shared_ptr<RobotPath> snapshot;		// The copy of the path that is generated
+		bool preview;								// If true, generate at preview fidelity
+		Priority priority;							// The class of the request
+		Priority requested;							// The class it was requested with, before it was selected
+		quint64 sequence;							// The order of the request within its class
+		qint64 queued;								// The time the request was queued
+		qint64 changed;								// The time of the first edit it includes, zero if none
+		quint64 batch;								// The batch that alone asked for it, zero if none
+	};
+
+	void queuePath(GeneratorType type, std::shared_ptr<RobotPath> path, bool preview, Priority priority, quint64 batch);
+
 private:
 	QMutex pending_queue_mutex_;
-	QList<QPair<GeneratorType, std::shared_ptr<RobotPath>>> pending_queue_;
+	QHash<const RobotPath*, Request> pending_queue_;
+	const RobotPath* selected_;
+	quint64 sequence_;
+	quint64 batch_sequence_;
 
 	QMutex trajectory_group_mutex_;
-	QMap<std::shared_ptr<RobotPath>, std::shared_ptr<TrajectoryGroup>> trajectories_;
+	TrajectoryStore trajectories_;
 
 	QMutex active_queue_mutex_;
-	GeneratorType active_type_;
-	std::shared_ptr<RobotPath> active_path_;
-
-	Generator* worker_;
-	QThread *thread_;
+	QMap<std::shared_ptr<RobotPath>, QPair<QThread*, std::shared_ptr<TrajectoryGroup>>> active_;
+	int thread_count_;
+	bool publish_progress_;
+	ResolutionPreset preset_;
+	bool adaptive_;
+	bool estimate_error_;
 
 	std::shared_ptr<RobotParams> robot_;
 	double timestep_;
 
+	GenerationMetrics metrics_;
+	QList<std::weak_ptr<GenerationBatch>> batches_;
+
 	QString logfile_;
 	QMutex loglock_;
 };
@@ -19,9 +19,19 @@
 #include "CheesyGenerator.h"
 #include "TrajectoryNames.h"
 #include "TrajectoryUtils.h"
+#include "Tracer.h"
+#include "AllocationCounter.h"
+#include "GenerationCapture.h"
 #include <QtCore/QThread>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDir>
+#include <QtCore/QDebug>
+#include <stdexcept>
+#include <algorithm>
 
 int Generator::global_which_ = 1;
+QMutex Generator::capture_lock_;
+QString Generator::capture_dir_;
 
 Generator::Generator(const QString& logfile, QMutex& mutex, double timestep, std::shared_ptr<RobotParams> robot, std::shared_ptr<TrajectoryGroup> group)
 	: logfile_(logfile), loglock_(mutex)
@@ -29,139 +39,239 @@ Generator::Generator(const QString& logfile, QMutex& mutex, double timestep, std
 	timestep_ = timestep;
 	group_ = group;
 	robot_ = robot ;
+	has_resolution_ = false;
+	preset_ = ResolutionPreset::Standard;
+	adaptive_ = false;
+	estimate_error_ = false;
+	publish_progress_ = false;
 
 	which_ = global_which_++;
 }
 
+Generator::Resolution Generator::defaultResolution(const QString& units)
+{
+	return resolution(units, ResolutionPreset::Standard, false);
+}
+
+Generator::Resolution Generator::resolution(const QString& units, ResolutionPreset preset, bool adaptive)
+{
+	Resolution res;
+
+	//
+	// The standard preset is the resolution that has always been used, the others
+	// are half and twice as fine.  An adaptive step is up to four times the fixed step
+	// on straight sections and down to a quarter of it in tight turns.
+	//
+	double scale = 1.0;
+	if (preset == ResolutionPreset::Draft)
+		scale = 2.0;
+	else if (preset == ResolutionPreset::Precise)
+		scale = 0.5;
+
+	res.diststep = UnitConverter::convert(1.0 * scale, "in", units);			// 1 inch works well, convert to units being used
+	res.maxdx = UnitConverter::convert(2.0 * scale, "in", units);				// 2 inches works well, convert to units being used
+	res.maxdy = UnitConverter::convert(0.5 * scale, "in", units);				// 0.5 inches works well, convert to units being used
+	res.maxtheta = 0.1 * scale;
+	res.adaptive = adaptive;
+	res.minstep = res.diststep / 4.0;
+	res.maxstep = res.diststep * 4.0;
+	res.maxturn = 0.025 * scale;
+
+	return res;
+}
+
+Generator::Resolution Generator::referenceResolution(const QString& units)
+{
+	Resolution res = resolution(units, ResolutionPreset::Precise, false);
+
+	res.diststep /= 2.0;
+	res.maxdx /= 2.0;
+	res.maxdy /= 2.0;
+	res.maxtheta /= 2.0;
+
+	return res;
+}
+
+Generator::Resolution Generator::previewResolution(const QString& units)
+{
+	Resolution res;
+
+	res.diststep = UnitConverter::convert(4.0, "in", units);
+	res.maxdx = UnitConverter::convert(8.0, "in", units);
+	res.maxdy = UnitConverter::convert(2.0, "in", units);
+	res.maxtheta = 0.3;
+	res.adaptive = false;
+	res.minstep = res.diststep;
+	res.maxstep = res.diststep;
+	res.maxturn = 0.0;
+
+	return res;
+}
+
+void Generator::setCaptureDirectory(const QString& dir)
+{
+	QMutexLocker lock(&capture_lock_);
+	capture_dir_ = dir;
+}
+
+QString Generator::captureDirectory()
+{
+	QMutexLocker lock(&capture_lock_);
+	return capture_dir_;
+}
+
+void Generator::publishProgress(const PathTrajectory& traj)
+{
+	auto interim = std::make_shared<TrajectoryGroup>(group_->type(), group_->path());
+	interim->setSnapshot(group_->snapshot());
+	interim->setInterim(true);
+	interim->setTimestep(group_->timestep());
+	interim->setWarmStart(warm_start_);
+	interim->addTrajectory(std::make_shared<PathTrajectory>(traj));
+
+	emit trajectoryProgress(interim);
+}
+
 void Generator::generateTrajectory()
 {
-	auto path = group_->path();
-	std::shared_ptr<PathTrajectory> traj;
+	auto path = group_->snapshot();
+	Tracer::Span span(Tracer::GeneratorCategory, "generate", path.get());
 
-	double diststep = UnitConverter::convert(1.0, "in", path->units());			// 1 inch works well, convert to units being used
-	double maxdx = UnitConverter::convert(2.0, "in", path->units());			// 2 inches works well, convert to units being used
-	double maxdy = UnitConverter::convert(0.5, "in", path->units());			// 0.5 inches works well, convert to units being used
-	double maxtheta = 0.1;
+	bool preview = group_->isPreview();
+	double timestep = preview ? std::max(timestep_, PreviewTimestep) : timestep_;
 
-	if (group_->type() == GeneratorType::CheesyPoofs) {
-		CheesyGenerator gen(logfile_, loglock_, which_, diststep, timestep_, maxdx, maxdy, maxtheta, robot_, false);
-		auto traj = gen.generate(path);
+	Resolution res;
+	if (has_resolution_) {
+		res = resolution_;
+	}
+	else if (preview) {
+		res = previewResolution(path->units());
+	}
+	else {
+		res = resolution(path->units(), preset_, adaptive_);
+	}
 
-		if (traj != nullptr) {
-			group_->addTrajectory(traj);
+	QString capdir = captureDirectory();
+	if (capdir.length() > 0 && !preview) {
+		QString msg;
+		QString filename = QDir(capdir).absoluteFilePath(path->fullname() + "." + GenerationCapture::Extension);
+		if (!GenerationCapture::write(filename, path, group_->type(), robot_, timestep_, res, warm_start_, msg)) {
+			qWarning() << "cannot capture the generation of path '" << path->fullname() << "' - " << msg;
 		}
 	}
-	else if (group_->type() == GeneratorType::ErrorCodeXeroSwerve) {
-		CheesyGenerator gen(logfile_, loglock_, which_, diststep, timestep_, maxdx, maxdy, maxtheta, robot_, true);
-		auto traj = gen.generate(path);
 
-		if (traj != nullptr) {
-			group_->addTrajectory(traj);
+	//
+	// Record only the robot parameters the generation itself reads, not the ones
+	// written to the capture file
+	//
+	robot_->clearFieldsRead();
+
+	AllocationCounter::Scope allocs;
+	QElapsedTimer timer;
+	timer.start();
+
+	group_->setTimestamp(TrajectoryGroup::Event::Started, Tracer::now());
+	group_->setTimestep(timestep);
+
+	//
+	// The group passes the seed it was given on to the next generation of the path,
+	// unless a full generation settles on percentages of its own.  A preview stops
+	// short at a coarser resolution, and a generation that fails settles on none.
+	//
+	group_->setWarmStart(warm_start_);
+
+	try {
+		if (group_->type() == GeneratorType::CheesyPoofs || group_->type() == GeneratorType::ErrorCodeXeroSwerve) {
+			bool xeromode = (group_->type() == GeneratorType::ErrorCodeXeroSwerve);
+			CheesyGenerator gen(logfile_, loglock_, which_, res.diststep, timestep, res.maxdx, res.maxdy, res.maxtheta, robot_, xeromode);
+			if (preview) {
+				gen.setMaxIterations(PreviewMaxIterations);
+			}
+			if (res.adaptive) {
+				gen.setAdaptiveStep(res.minstep, res.maxstep, res.maxturn);
+			}
+			gen.setWarmStart(warm_start_);
+
+			QElapsedTimer progress;
+			if (publish_progress_ && !preview) {
+				gen.setProgressCallback([this, &progress](const PathTrajectory& traj) {
+					if (!progress.isValid() || progress.elapsed() >= ProgressInterval) {
+						progress.start();
+						publishProgress(traj);
+					}
+				});
+			}
+
+			auto traj = gen.generate(path);
+
+			if (traj != nullptr) {
+				group_->addTrajectory(traj);
+				group_->setTimedTrajectory(gen.timedTrajectory());
+			}
+			else {
+				group_->setErrorMessage("the path cannot be generated with the given waypoints and constraints");
+			}
+			group_->setStats(gen.stats());
+			if (!preview && !gen.warmStart().isEmpty()) {
+				group_->setWarmStart(gen.warmStart());
+			}
 		}
 	}
+	catch (const std::runtime_error& ex) {
+		group_->setErrorMessage(ex.what());
+	}
 
-	if (!group_->hasError()) {
+	group_->setRobotFields(robot_->fieldsRead());
+
+	if (!group_->hasError() && !preview) {
 		if (robot_->getDriveType() == RobotParams::DriveType::TankDrive) {
 			//
 			// Add in trajectories for the left and right wheels.  These are here
-			// as they will always be independent of how the main trajectory is generated
+			// as they will always be independent of how the main trajectory is generated.
+			// A preview only shows the main trajectory, so it leaves them out.
 			//
-			addTankDriveTrajectories();
+			double width = UnitConverter::convert(robot_->getWheelBaseWidth(), robot_->getLengthUnits(), path->units());
+			TrajectoryUtils::addTankDriveTrajectories(*group_, width);
 		}
 	}
 
-	emit trajectoryComplete(group_);
-}
+	group_->setGenerationTime(timer.nsecsElapsed() / 1.0e9);
+	group_->setAllocations(allocs.stats());
+	group_->setTimestamp(TrajectoryGroup::Event::Generated, Tracer::now());
 
-void Generator::addTankDriveTrajectories()
-{
 	//
-	// Get the width of the robot in the same units used by the paths
+	// The estimate is made after the generation is timed so it does not count against it
 	//
-	double width = UnitConverter::convert(robot_->getWheelBaseWidth(), robot_->getLengthUnits(), group_->path()->units());
-
-	auto traj = group_->getTrajectory(TrajectoryName::Main);
-	if (traj == nullptr) {
-		return;
+	if (estimate_error_ && !preview && !group_->hasError()) {
+		estimateError(timestep);
 	}
 
-	QVector<Pose2dWithTrajectory> leftpts;
-	QVector<Pose2dWithTrajectory> rightpts;
-
-	double lcurv = 0, rcurv = 0;
-	double lvel = 0, lacc = 0, lpos = 0;
-	double rvel = 0, racc = 0, rpos = 0;
-	double plx = 0, ply = 0, prx = 0, pry = 0;
-	double plvel = 0, prvel = 0;
-	double placc = 0, pracc = 0;
-
-	for (int i = 0; i < traj->size(); i++)
-	{
-		const Pose2dWithTrajectory& pt = (*traj)[i];
-		double time = pt.time();
-		double px = pt.x();
-		double py = pt.y();
-
-		double lx = px - width * pt.rotation().getSin() / 2.0;
-		double ly = py + width * pt.rotation().getCos() / 2.0;
-		double rx = px + width * pt.rotation().getSin() / 2.0;
-		double ry = py - width * pt.rotation().getCos() / 2.0;
-
-		if (i == 0)
-		{
-			lvel = 0.0;
-			lacc = 0.0;
-			lpos = 0.0;
-
-			rvel = 0.0;
-			racc = 0.0;
-			rpos = 0.0;
-		}
-		else
-		{
-			double dt = time - (*traj)[i - 1].time();
-			double ldist = std::sqrt((lx - plx) * (lx - plx) + (ly - ply) * (ly - ply));
-			double rdist = std::sqrt((rx - prx) * (rx - prx) + (ry - pry) * (ry - pry));
+	emit trajectoryComplete(group_);
+}
 
-			lvel = ldist / dt;
-			rvel = rdist / dt;
+void Generator::estimateError(double timestep)
+{
+	auto path = group_->snapshot();
+	auto main = group_->getTrajectory(TrajectoryName::Main);
+	if (main == nullptr)
+		return;
 
-			lacc = (lvel - plvel) / dt;
-			racc = (rvel - prvel) / dt;
+	Tracer::Span span(Tracer::GeneratorCategory, "estimateerror", path.get());
+	Resolution ref = referenceResolution(path->units());
 
-			lpos += ldist;
-			rpos += rdist;
-		}
+	try {
+		bool xeromode = (group_->type() == GeneratorType::ErrorCodeXeroSwerve);
+		CheesyGenerator gen(logfile_, loglock_, which_, ref.diststep, timestep, ref.maxdx, ref.maxdy, ref.maxtheta, robot_, xeromode);
+		gen.setWarmStart(group_->warmStart());
 
-		Translation2d lpt(lx, ly);
-		Pose2d l2d(lpt, pt.rotation());
-		Pose2dWithTrajectory ltraj(l2d, time, lpos, lvel, lacc);
-		leftpts.push_back(ltraj);
-
-		Translation2d rpt(rx, ry);
-		Pose2d r2d(rpt, pt.rotation());
-		Pose2dWithTrajectory rtraj(r2d, time, rpos, rvel, racc);
-		rightpts.push_back(rtraj);
-
-		plx = lx;
-		ply = ly;
-		prx = rx;
-		pry = ry;
-		plvel = lvel;
-		prvel = rvel;
-		placc = lacc;
-		pracc = racc;
+		auto reftraj = gen.generate(path);
+		if (reftraj != nullptr) {
+			group_->setResolutionError(TrajectoryUtils::compare(*main, *reftraj));
+		}
 	}
-
-	assert(leftpts.size() == rightpts.size());
-
-	std::shared_ptr<PathTrajectory> left = std::make_shared<PathTrajectory>(TrajectoryName::Left, leftpts);
-	TrajectoryUtils::computeCurvature(left);
-
-	std::shared_ptr<PathTrajectory> right = std::make_shared<PathTrajectory>(TrajectoryName::Right, rightpts);
-	TrajectoryUtils::computeCurvature(right);
-
-
-	group_->addTrajectory(left);
-	group_->addTrajectory(right);
-}
\ No newline at end of file
+	catch (const std::runtime_error&) {
+		//
+		// The path generated at its own resolution, so it is kept without an estimate
+		//
+	}
+}
@@ -19,6 +19,7 @@
 #include "GeneratorType.h"
 #include "TrajectoryGroup.h"
 #include "RobotParams.h"
+#include "ResolutionPreset.h"
 #include <QtCore/QObject>
 #include <QtCore/QMutex>
 #include <memory>
@@ -27,25 +28,120 @@ class Generator : public QObject
 {
 	Q_OBJECT
 
+public:
+	//
+	// How finely the splines are broken into points, in the units of the path
+	//
+	struct Resolution
+	{
+		double diststep;
+		double maxdx;
+		double maxdy;
+		double maxtheta;
+		bool adaptive;					// If true, the steps vary from minstep to maxstep instead of being diststep
+		double minstep;
+		double maxstep;
+		double maxturn;					// The most an adaptive step turns the heading and rotation, in radians
+	};
+
 public:
 	Generator(const QString& logfile, QMutex& mutex, double timestep, std::shared_ptr<RobotParams> robot, std::shared_ptr<TrajectoryGroup> group);
 
 	void generateTrajectory();
 
+	//
+	// Replaces the default resolution, used to replay a captured generation exactly
+	//
+	void setResolution(const Resolution& res) {
+		resolution_ = res;
+		has_resolution_ = true;
+	}
+
+	static Resolution defaultResolution(const QString& units);
+
+	//
+	// The resolution of a preset, with fixed or adaptive steps
+	//
+	static Resolution resolution(const QString& units, ResolutionPreset preset, bool adaptive);
+
+	//
+	// The much finer resolution the error of a generation is estimated against
+	//
+	static Resolution referenceResolution(const QString& units);
+
+	void setResolutionPreset(ResolutionPreset preset, bool adaptive) {
+		preset_ = preset;
+		adaptive_ = adaptive;
+	}
+
+	//
+	// When enabled, each full generation is compared with the same path generated at the
+	// reference resolution, and the difference is stored in the trajectory group
+	//
+	void setEstimateError(bool estimate) {
+		estimate_error_ = estimate;
+	}
+
+	//
+	// Preview generations use a coarser resolution and timestep and limit the swerve
+	// iterations, so a typical path previews in a few milliseconds
+	//
+	static Resolution previewResolution(const QString& units);
+
+	static constexpr double PreviewTimestep = 0.05;
+	static constexpr int PreviewMaxIterations = 8;
+
+	//
+	// When enabled, intermediate trajectories of a path that takes more than one
+	// iteration are published with trajectoryProgress(), at most once per
+	// ProgressInterval milliseconds.  Previews never publish progress.
+	//
+	void setPublishProgress(bool publish) {
+		publish_progress_ = publish;
+	}
+
+	static constexpr int ProgressInterval = 33;
+
+	//
+	// The swerve velocity percentages of an earlier generation of the path, which the
+	// search starts from
+	//
+	void setWarmStart(const WarmStart& seed) {
+		warm_start_ = seed;
+	}
+
+	//
+	// When the capture directory is set, the inputs to every generation are written to
+	// a replay file in the directory before the path is generated
+	//
+	static void setCaptureDirectory(const QString& dir);
+	static QString captureDirectory();
+
 signals:
+	void trajectoryProgress(std::shared_ptr<TrajectoryGroup> interim);
 	void trajectoryComplete(std::shared_ptr<TrajectoryGroup> group);
 
 private:
-	void addTankDriveTrajectories();
+	void publishProgress(const PathTrajectory& traj);
+	void estimateError(double timestep);
 
 private:
 	int which_;
 	double timestep_;
 	std::shared_ptr<TrajectoryGroup> group_;
 	std::shared_ptr<RobotParams> robot_;
+	Resolution resolution_;
+	bool has_resolution_;
+	ResolutionPreset preset_;
+	bool adaptive_;
+	bool estimate_error_;
+	WarmStart warm_start_;
+	bool publish_progress_;
 
 	const QString& logfile_;
 	QMutex& loglock_;
 
 	static int global_which_;
+	static QMutex capture_lock_;
+	static QString capture_dir_;
 };
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "TrajectoryUtils.h"
 #include "RobotPath.h"
 #include "TrajectoryNames.h"
+#include "Tracer.h"
 #include <QtCore/QStandardPaths>
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
@@ -32,10 +33,17 @@ GeneratorBase::GeneratorBase(const QString &logfile, QMutex& loglock, int which,
 	maxDx_ = maxdx;
 	maxDy_ = maxdy;
 	maxDTheta_ = maxtheta;
+	max_iterations_ = 0;
+	adaptive_ = false;
+	min_step_ = diststep;
+	max_step_ = diststep;
+	max_turn_ = 0.0;
 }
 
 void GeneratorBase::logMessage(const QString& msg)
 {
+	Tracer::Span span(Tracer::LogCategory, "log");
+
 	loglock_.lock();
 
 	QFile file(logfile_);
@@ -55,23 +63,42 @@ GeneratorBase::generateInternal(std::shared_ptr<RobotPath> path, QVector<std::sh
 	double maxDyPath = UnitConverter::convert(maxDy_, robot()->getLengthUnits(), path->units());
 	double distSteppath = UnitConverter::convert(diststep_, robot()->getLengthUnits(), path->units());
 
+	QElapsedTimer timer;
+	timer.start();
+
+	Tracer::Span span(Tracer::GeneratorCategory, "splines", path.get());
+
 	//
-	// Step 1: generate a set of splines that represent the path
-	//         (taken from the cheesy poofs code)
+	// Step 1: get the set of splines that represent the path (taken from the cheesy poofs
+	//         code).  These are shared with the path editor and are usually already made.
 	//
-	QVector<std::shared_ptr<SplinePair>> splines = generateSplines(path->waypoints());
+	std::shared_ptr<const SplineSet> splines = path->splines();
+	stats_.add(GeneratorStats::Stage::Splines, timer.nsecsElapsed());
+	timer.start();
+	span.next("parameterize");
 
 	//
 	// Step 2: generate a set of points that represent the path where the curvature, x, and y do not 
 	//         differ to an amount greater than maxDx_, maxDy_, maxDTheta_
 	//         (taken from the cheesy poofs code)
 	//
-	QVector<Pose2dWithRotation> paramtraj = TrajectoryUtils::parameterize(splines, maxDxPath, maxDyPath, maxDTheta_);
+	QVector<int> ends;
+	QVector<Pose2dWithRotation> paramtraj = TrajectoryUtils::parameterize(*splines, maxDxPath, maxDyPath, maxDTheta_, adaptive_ ? &ends : nullptr);
+	stats_.add(GeneratorStats::Stage::Parameterize, timer.nsecsElapsed());
+	timer.start();
+	span.next("distanceview");
 
 	//
-	// Step 3: generate a set of points that are equi-distant apart (diststep_).
+	// Step 3: generate a set of points that are equi-distant apart (diststep_), or in
+	// adaptive mode closer together where the path and the robot turn faster
 	//
-	DistanceView distview(paramtraj, distSteppath);
+	DistanceView distview = adaptive_ ?
+		DistanceView(paramtraj, UnitConverter::convert(min_step_, robot()->getLengthUnits(), path->units()),
+			UnitConverter::convert(max_step_, robot()->getLengthUnits(), path->units()), max_turn_, rotationRates(path, paramtraj, ends)) :
+		DistanceView(paramtraj, distSteppath);
+	stats_.add(GeneratorStats::Stage::DistanceView, timer.nsecsElapsed());
+	timer.start();
+	span.next("timeparameterize");
 
 	if (distview.size() == 1 && distview.length() < 1e-4) {
 		//
@@ -90,23 +117,27 @@ GeneratorBase::generateInternal(std::shared_ptr<RobotPath> path, QVector<std::sh
 	constraints.append(extras);
 	QVector<Pose2dWithTrajectory> pts = timeParameterize(distview, constraints, params.startVelocity(),
 		params.endVelocity(), params.maxVelocity(), params.maxAccel());
+	stats_.add(GeneratorStats::Stage::TimeParameterize, timer.nsecsElapsed());
+	timer.start();
+	span.next("uniformtime");
 
 	//
-	// Step 5: convert the timeview view to a uniform timing view
+	// Keep the non-uniform timed trajectory so that it can be resampled at other
+	// rates later without running the generator again
 	//
-	QVector<Pose2dWithTrajectory> uniform = convertToUniformTime(pts, timestep_);
-
+	timed_ = std::make_shared<PathTrajectory>(TrajectoryName::Main, pts);
 
 	//
-	// Step 6: compute the curvature for the path
+	// Step 5: convert the timeview view to a uniform timing view
 	//
-	auto traj = std::make_shared<PathTrajectory>(TrajectoryName::Main, uniform);
-	TrajectoryUtils::computeCurvature(traj);
+	QVector<Pose2dWithTrajectory> uniform = TrajectoryUtils::convertToUniformTime(pts, timestep_);
+	stats_.add(GeneratorStats::Stage::UniformTime, timer.nsecsElapsed());
 
 	//
-	// Return a trajectory
+	// Return a trajectory.  The curvature of each point was evaluated from the splines
+	// and interpolated through every stage, so it is not computed again here.
 	//
-	return traj;
+	return std::make_shared<PathTrajectory>(TrajectoryName::Main, uniform);
 }
 
 
@@ -118,19 +149,32 @@ void GeneratorBase::computeRobotParameters(std::shared_ptr<RobotPath> path)
 	robot_max_accel_ = UnitConverter::convert(robot_->getMaxAccel(), robot_->getLengthUnits(), path->units());
 }
 
-QVector<std::shared_ptr<SplinePair>>
-GeneratorBase::generateSplines(const QVector<Pose2dWithRotation>& points)
+//
+// The rate, in radians per unit of distance, the robot rotates between the waypoints
+// at the ends of each segment of the parameterized points
+//
+QVector<double> GeneratorBase::rotationRates(std::shared_ptr<RobotPath> path, const QVector<Pose2dWithRotation>& points, const QVector<int>& ends)
 {
-	QVector<std::shared_ptr<SplinePair>> splines;
+	QVector<double> rates(points.size(), 0.0);
+	const QVector<Pose2dWithRotation>& waypoints = path->waypoints();
+
+	int start = 0;
+	for (int i = 0; i < ends.size() && i + 1 < waypoints.size(); i++) {
+		double len = 0.0;
+		for (int j = start; j < ends[i]; j++)
+			len += points[j + 1].distance(points[j]);
+
+		double turn = MathUtils::boundDegrees(waypoints[i + 1].getSwrot().toDegrees() - waypoints[i].getSwrot().toDegrees());
+		if (len > 1e-9) {
+			double rate = std::fabs(MathUtils::degreesToRadians(turn)) / len;
+			for (int j = start; j < ends[i]; j++)
+				rates[j] = rate;
+		}
 
-	for (int i = 0; i < points.size() - 1; i++) {
-		const Pose2dWithRotation& p1 = points[i];
-		const Pose2dWithRotation& p2 = points[i + 1];
-		auto pair = std::make_shared<SplinePair>(p1, p2);
-		splines.push_back(pair);
+		start = ends[i];
 	}
 
-	return splines;
+	return rates;
 }
 
 QVector<Pose2dWithTrajectory>
@@ -292,59 +336,6 @@ GeneratorBase::timeParameterize(const DistanceView& view, const QVector<std::sha
 }
 
 
-int GeneratorBase::findIndex(const QVector<Pose2dWithTrajectory>& traj, double time)
-{
-	if (time < traj[0].time())
-		return 0;
-
-	if (time > traj[traj.size() - 1].time())
-		return traj.size() - 1;
-
-	int low = 0;
-	int high = traj.size() - 1;
-
-	while (high - low > 1)
-	{
-		int center = (high + low) / 2;
-		if (time > traj[center].time())
-		{
-			low = center;
-		}
-		else
-		{
-			high = center;
-		}
-	}
-
-	return low;
-}
-
-QVector<Pose2dWithTrajectory> GeneratorBase::convertToUniformTime(const QVector<Pose2dWithTrajectory>& traj, double step)
-{
-	QVector<Pose2dWithTrajectory> result;
-
-	for (double time = 0.0; time < traj[traj.size() - 1].time(); time += step)
-	{
-		Pose2dWithTrajectory newpt;
-
-		int low = findIndex(traj, time);
-		if (low == traj.size() - 1)
-		{
-			newpt = traj[traj.size() - 1];
-		}
-		else
-		{
-			double percent = (time - traj[low].time()) / (traj[low + 1].time() - traj[low].time());
-			newpt = traj[low].interpolate(traj[low + 1], percent);
-		}
-
-		result.push_back(newpt);
-	}
-
-	return result;
-}
-
-
 int GeneratorBase::findIndexFromLocation(std::shared_ptr<PathTrajectory> traj, int start, const Translation2d& loc)
 {
 	static double tol = 0.05;
@@ -395,8 +386,7 @@ Translation2d GeneratorBase::getWheelPerpendicularVector(Wheel w, double magnitu
 
 bool GeneratorBase::modifyForRotation(std::shared_ptr<RobotPath> path, std::shared_ptr<PathTrajectory> traj, double percent)
 {
-	QVector<std::shared_ptr<SplinePair>> splines = generateSplines(path->waypoints());
-	QVector<double> dists = TrajectoryUtils::getDistancesForSplines(splines);
+	const QVector<double>& dists = path->splines()->distances();
 	assert(dists.size() == path->waypoints().size());
 
 	for (int i = 0; i < path->size() - 1; i++) 
@@ -451,6 +441,8 @@ bool GeneratorBase::modifyForRotation(std::shared_ptr<RobotPath> path, std::shar
 
 bool GeneratorBase::modifySegmentForRotation(std::shared_ptr<RobotPath> path, std::shared_ptr<PathTrajectory> traj, double percent, int start, int end, double startRot, double startRotVel, double endRot, double endRotVel)
 {
+	GeneratorStats::Scope scope(stats_, GeneratorStats::Stage::Rotation);
+	Tracer::Span span(Tracer::GeneratorCategory, "rotation", path.get());
 	QString logmsg;
 
 	assert(start >= 0 && start < traj->size());
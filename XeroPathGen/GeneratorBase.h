@@ -15,16 +15,18 @@
 //
 #pragma once
 
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "Pose2dWithRotation.h"
 #include "Pose2dWithTrajectory.h"
 #include "PathConstraint.h"
 #include "DistanceView.h"
 #include "SwerveWheels.h"
 #include "PathTrajectory.h"
+#include "GeneratorStats.h"
 #include <QtCore/QVector>
 #include <QtCore/QMutex>
 #include <memory>
+#include <functional>
 
 class RobotParams;
 
@@ -37,6 +39,53 @@ public:
 		return robot_;
 	}
 
+	//
+	// The non-uniform timed trajectory from the most recent call to generateInternal()
+	//
+	std::shared_ptr<PathTrajectory> timedTrajectory() {
+		return timed_;
+	}
+
+	//
+	// The time spent in each stage of generation since this generator was created
+	//
+	const GeneratorStats& stats() const {
+		return stats_;
+	}
+
+	//
+	// The most times a swerve path is regenerated at a lower velocity to make room
+	// for its rotation, zero for no limit.  When the limit is reached the last
+	// trajectory is returned even though the rotation may not be reachable.
+	//
+	void setMaxIterations(int count) {
+		max_iterations_ = count;
+	}
+
+	int maxIterations() const {
+		return max_iterations_;
+	}
+
+	//
+	// Break the path into steps from minstep to maxstep long, each turning the heading
+	// and rotation of the robot at most maxturn radians, rather than into steps of the
+	// fixed distance step.  The lengths are in the length units of the robot.
+	//
+	void setAdaptiveStep(double minstep, double maxstep, double maxturn) {
+		adaptive_ = true;
+		min_step_ = minstep;
+		max_step_ = maxstep;
+		max_turn_ = maxturn;
+	}
+
+	//
+	// Called, on the generating thread, with each intermediate trajectory of a path
+	// that takes more than one iteration to generate
+	//
+	void setProgressCallback(std::function<void(const PathTrajectory&)> cb) {
+		progress_ = cb;
+	}
+
 protected:
 	double getMaxDx() const { return maxDx_; }
 	double getMaxDy() const { return maxDy_; }
@@ -47,14 +96,11 @@ protected:
 	std::shared_ptr<PathTrajectory> generateInternal(std::shared_ptr<RobotPath> path, QVector<std::shared_ptr<PathConstraint>>& extras);
 	void computeRobotParameters(std::shared_ptr<RobotPath> path);
 
-	QVector<std::shared_ptr<SplinePair>> generateSplines(const QVector<Pose2dWithRotation>& points);
+	QVector<double> rotationRates(std::shared_ptr<RobotPath> path, const QVector<Pose2dWithRotation>& points, const QVector<int>& ends);
 
 	QVector<Pose2dWithTrajectory> timeParameterize(const DistanceView& view, const QVector<std::shared_ptr<PathConstraint>>& constraints,
 		double startvel, double endvel, double maxvel, double maxaccel);
 
-	QVector<Pose2dWithTrajectory> convertToUniformTime(const QVector<Pose2dWithTrajectory>& traj, double step);
-	int findIndex(const QVector<Pose2dWithTrajectory>& traj, double time);
-
 
 	Translation2d getWheelPerpendicularVector(Wheel w, double magnitude);
 	int findIndexFromLocation(std::shared_ptr<PathTrajectory> traj, int start, const Translation2d& loc);
@@ -80,8 +126,22 @@ protected:
 
 	void logMessage(const QString& msg);
 
+	void setFinalPercent(double percent) {
+		stats_.setFinalPercent(percent);
+	}
+
+	void publishProgress(std::shared_ptr<PathTrajectory> traj) {
+		if (progress_ && traj != nullptr) {
+			progress_(*traj);
+		}
+	}
+
 private:
 	std::shared_ptr<RobotParams> robot_;
+	std::shared_ptr<PathTrajectory> timed_;
+	GeneratorStats stats_;
+	int max_iterations_;
+	std::function<void(const PathTrajectory&)> progress_;
 
 	double robot_max_accel_;
 	double robot_max_velocity_;
@@ -94,6 +154,11 @@ private:
 	double diststep_;
 	double timestep_;
 
+	bool adaptive_;
+	double min_step_;
+	double max_step_;
+	double max_turn_;
+
 	const QString &logfile_;
 	QMutex &loglock_;
 	int which_;
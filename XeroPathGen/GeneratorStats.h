@@ -0,0 +1,146 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QtGlobal>
+#include <algorithm>
+
+//
+// The time spent in each stage of generating a path.  A stage may run many times
+// for one path (e.g. once per iteration of the swerve rotation search) so both the
+// total time and the number of times the stage ran are kept.
+//
+class GeneratorStats
+{
+public:
+	enum class Stage : int
+	{
+		Splines,
+		Parameterize,
+		DistanceView,
+		TimeParameterize,
+		UniformTime,
+		Rotation,
+		Count
+	};
+
+	static constexpr int StageCount = static_cast<int>(Stage::Count);
+
+	//
+	// Adds the time from construction to destruction to a stage
+	//
+	class Scope
+	{
+	public:
+		Scope(GeneratorStats& stats, Stage stage) : stats_(stats), stage_(stage) {
+			timer_.start();
+		}
+
+		~Scope() {
+			stats_.add(stage_, timer_.nsecsElapsed());
+		}
+
+	private:
+		GeneratorStats& stats_;
+		Stage stage_;
+		QElapsedTimer timer_;
+	};
+
+public:
+	GeneratorStats() {
+		clear();
+	}
+
+	void clear() {
+		for (int i = 0; i < StageCount; i++) {
+			nsecs_[i] = 0;
+			calls_[i] = 0;
+		}
+		percent_ = 1.0;
+	}
+
+	void add(Stage stage, qint64 nsecs) {
+		nsecs_[static_cast<int>(stage)] += nsecs;
+		calls_[static_cast<int>(stage)]++;
+	}
+
+	void merge(const GeneratorStats& other) {
+		for (int i = 0; i < StageCount; i++) {
+			nsecs_[i] += other.nsecs_[i];
+			calls_[i] += other.calls_[i];
+		}
+		percent_ = std::min(percent_, other.percent_);
+	}
+
+	qint64 nsecs(Stage stage) const {
+		return nsecs_[static_cast<int>(stage)];
+	}
+
+	double seconds(Stage stage) const {
+		return nsecs(stage) / 1.0e9;
+	}
+
+	int calls(Stage stage) const {
+		return calls_[static_cast<int>(stage)];
+	}
+
+	//
+	// The number of times the linear trajectory was generated.  This is one unless
+	// the swerve rotation search had to lower the velocity and try again.
+	//
+	int iterations() const {
+		return calls(Stage::Splines);
+	}
+
+	//
+	// The lowest fraction of the path velocity left to linear motion on any segment
+	// once the swerve rotation search finished, 1.0 when rotation did not limit the path
+	//
+	double finalPercent() const {
+		return percent_;
+	}
+
+	void setFinalPercent(double percent) {
+		percent_ = percent;
+	}
+
+	static const char* stageName(Stage stage) {
+		switch (stage) {
+		case Stage::Splines:
+			return "splines";
+		case Stage::Parameterize:
+			return "parameterize";
+		case Stage::DistanceView:
+			return "distanceview";
+		case Stage::TimeParameterize:
+			return "timeparameterize";
+		case Stage::UniformTime:
+			return "uniformtime";
+		case Stage::Rotation:
+			return "rotation";
+		default:
+			break;
+		}
+
+		return "unknown";
+	}
+
+private:
+	qint64 nsecs_[StageCount];
+	int calls_[StageCount];
+	double percent_;
+};
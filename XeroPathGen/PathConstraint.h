@@ -39,11 +39,20 @@ public:
 	virtual QJsonObject toJSON() const = 0;
 	virtual QString toString() const = 0;
 
+	//
+	// A copy of this constraint that applies to another path
+	//
+	virtual std::shared_ptr<PathConstraint> clone(std::shared_ptr<RobotPath> path) const = 0;
+
 	std::shared_ptr<RobotPath> path() const {
-		return path_;
+		return path_.lock();
 	}
 
 private:
-	std::shared_ptr<RobotPath> path_;
+	//
+	// The path owns its constraints, so a constraint only refers back to its path
+	// weakly to avoid a reference cycle that would keep both alive
+	//
+	std::weak_ptr<RobotPath> path_;
 };
 
@@ -14,7 +14,7 @@
 // limitations under the License.
 //
 #include "PathFieldView.h"
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "PathsDataModel.h"
 #include "RobotPath.h"
 #include "PathGroup.h"
@@ -128,6 +128,28 @@ void PathFieldView::doPaint(QPainter &paint, bool printing)
 			drawRobot(paint);
 		}
 	}
+
+	if (!printing && overlay_text_.length() > 0) {
+		drawOverlay(paint);
+	}
+}
+
+void PathFieldView::drawOverlay(QPainter& paint)
+{
+	QFont font("Monospace");
+	font.setStyleHint(QFont::TypeWriter);
+	paint.setFont(font);
+
+	QFontMetrics fm(font);
+	QRect bounds = fm.boundingRect(QRect(0, 0, width(), height()), Qt::AlignLeft | Qt::AlignTop, overlay_text_);
+	bounds.translate(8, 8);
+
+	paint.setPen(Qt::NoPen);
+	paint.setBrush(QBrush(QColor(0, 0, 0, 160)));
+	paint.drawRect(bounds.adjusted(-4, -4, 4, 4));
+
+	paint.setPen(QPen(Qt::white));
+	paint.drawText(bounds, Qt::AlignLeft | Qt::AlignTop, overlay_text_);
 }
 
 void PathFieldView::emitMouseMoved(Translation2d pos)
@@ -668,11 +690,15 @@ void PathFieldView::drawOnePoint(QPainter& paint, const Pose2dWithRotation& pt,
 void PathFieldView::drawSplines(QPainter& paint)
 {
 	auto splines = path_data_model_.getSplinesForPath(path_) ;
-	for (int i = 0; i < splines.size(); i++)
-		drawSpline(paint, splines[i]);
+	for (int i = 0; i < splines->size(); i++)
+		drawSpline(paint, *splines, i);
 }
 
-void PathFieldView::findSplineStep(std::shared_ptr<SplinePair> pair)
+//
+// The step in the spline parameter that puts the dots drawn along the robot edges no
+// more than a pixel or two apart at the current scale of the view
+//
+double PathFieldView::findSplineStep(const SplinePair& pair)
 {
 	double step = 0.1;
 	double cx, cy;
@@ -685,8 +711,8 @@ void PathFieldView::findSplineStep(std::shared_ptr<SplinePair> pair)
 
 		for (double t = 0.0; t < 1.0; t += step) {
 
-			Translation2d loc = pair->evalPosition(t);
-			Rotation2d heading = pair->evalHeading(t);
+			Translation2d loc = pair.evalPosition(t);
+			Rotation2d heading = pair.evalHeading(t);
 
 			cx = loc.getX() - robot_width_ * heading.getSin() / 2.0;
 			cy = loc.getY() + robot_width_ * heading.getCos() / 2.0;
@@ -714,11 +740,12 @@ void PathFieldView::findSplineStep(std::shared_ptr<SplinePair> pair)
 		if (maxdist <= 2.0)
 			break;
 	}
-	pair->setStep(step);
+	return step;
 }
 
-void PathFieldView::drawSpline(QPainter& paint, std::shared_ptr<SplinePair> pair)
+void PathFieldView::drawSpline(QPainter& paint, const SplineSet& splines, int index)
 {
+	const SplinePair& pair = splines[index];
 	double px, py;
 	QColor c(0xF0, 0x80, 0x80, 0xFF);
 
@@ -728,13 +755,17 @@ void PathFieldView::drawSpline(QPainter& paint, std::shared_ptr<SplinePair> pair
 	QPen pen(c);
 	paint.setPen(pen);
 
-	if (!pair->hasStep())
-		findSplineStep(pair);
+	double scale = world_to_window_.m11();
+	double step = splines.renderStep(index, scale);
+	if (step == 0.0) {
+		step = findSplineStep(pair);
+		splines.setRenderStep(index, scale, step);
+	}
 
-	for (float t = 0.0f; t < 1.0f; t += pair->step())
+	for (float t = 0.0f; t < 1.0f; t += step)
 	{
-		Translation2d loc = pair->evalPosition(t);
-		Rotation2d heading = pair->evalHeading(t);
+		Translation2d loc = pair.evalPosition(t);
+		Rotation2d heading = pair.evalHeading(t);
 
 		px = loc.getX() - robot_width_ * heading.getSin() / 2.0;
 		py = loc.getY() + robot_width_ * heading.getCos() / 2.0;
@@ -19,7 +19,7 @@
 #include "RobotParams.h"
 #include "RobotPath.h"
 #include "Pose2d.h"
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "PathsDataModel.h"
 #include "PathTrajectory.h"
 #include <QWidget>
@@ -60,6 +60,14 @@ public:
 		update();
 	}
 
+	//
+	// Text drawn over the top left corner of the field, nothing is drawn if it is empty
+	//
+	void setOverlayText(const QString& text) {
+		overlay_text_ = text;
+		update();
+	}
+
 
 	QPointF worldToWindow(const QPointF& pt);
 	QPointF windowToWorld(const QPointF& pt);
@@ -128,7 +136,7 @@ private:
 	void copyCoordinates();
 	void pasteCoordinates(bool rot180);
 
-	void findSplineStep(std::shared_ptr<SplinePair> pair);
+	double findSplineStep(const SplinePair& pair);
 
 	void pathChanged(const QString& grname, const QString& pathname);
 
@@ -149,10 +157,11 @@ private:
 	void drawPoints(QPainter& paint);
 	void drawOnePoint(QPainter& paint, const Pose2dWithRotation& pt, bool selected);
 	void drawSplines(QPainter &paint);
-	void drawSpline(QPainter& paint, std::shared_ptr<SplinePair> pair);
+	void drawSpline(QPainter& paint, const SplineSet& splines, int index);
 	void drawRobot(QPainter& paint);
 	void drawWheel(QPainter& paint, QBrush& brush, const Translation2d& loc, const Pose2dWithRotation& pt);
 	void drawRobot(QPainter& paint, const Pose2dWithRotation& pose, QColor body, QColor wheel);
+	void drawOverlay(QPainter& paint);
 	bool hitTestWaypoint(const QPointF& pt, int& index, WaypointRegion& region);
 	void invalidateWaypoint(int index);
 
@@ -184,4 +193,6 @@ private:
 
 	std::shared_ptr<PathTrajectory> traj_;
 	double traj_time_;
+
+	QString overlay_text_;
 };
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "RobotPath.h"
+#include "PathVariant.h"
 #include <QtCore/QString>
 #include <QtCore/QList>
 #include <memory>
@@ -74,8 +75,26 @@ public:
 		return paths_;
 	}
 
+	//
+	// The variants written for every path in the group, e.g. the other alliance's copy
+	//
+	const QVector<PathVariant>& variants() const {
+		return variants_;
+	}
+
+	void setVariants(const QVector<PathVariant>& variants) {
+		variants_ = variants;
+	}
+
+	void convert(const QString& from, const QString& to) {
+		for (PathVariant& variant : variants_) {
+			variant.convert(from, to);
+		}
+	}
+
 private:
 	QString name_;
 	QList<std::shared_ptr<RobotPath>> paths_;
+	QVector<PathVariant> variants_;
 };
 
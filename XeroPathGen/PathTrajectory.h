@@ -61,6 +61,10 @@ public:
 		return name_;
 	}
 
+	const QVector<Pose2dWithTrajectory>& points() const {
+		return points_;
+	}
+
 	int getIndex(double time);
 
 	bool getTimeForDistance(double dist, double& time);
@@ -81,6 +85,27 @@ public:
 
 	double getDistance(int index);
 
+	//
+	// Multiplies every length in the trajectory by a factor, e.g. to change its units.
+	// Times, headings and rotational velocities are unchanged.
+	//
+	void scale(double s) {
+		for (Pose2dWithTrajectory& pt : points_) {
+			pt.scale(s);
+		}
+
+		for (double& d : distances_) {
+			d *= s;
+		}
+	}
+
+	//
+	// An estimate of the heap memory held by this trajectory in bytes
+	//
+	qint64 memoryUsage() const {
+		return sizeof(PathTrajectory) + points_.capacity() * sizeof(Pose2dWithTrajectory) + distances_.capacity() * sizeof(double);
+	}
+
 private:
 	QString name_;
 	QVector<Pose2dWithTrajectory> points_;
@@ -0,0 +1,250 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "PathVariant.h"
+#include "TrajectoryGroup.h"
+#include "TrajectoryNames.h"
+#include "UnitConverter.h"
+
+PathVariant::PathVariant()
+{
+	type_ = Type::Mirror;
+	angle_ = 0.0;
+}
+
+PathVariant::PathVariant(const QString& name, Type type, const Translation2d& fieldsize)
+{
+	name_ = name;
+	type_ = type;
+	field_size_ = fieldsize;
+	angle_ = 0.0;
+}
+
+PathVariant::PathVariant(const QString& name, const Translation2d& offset, double angle)
+{
+	name_ = name;
+	type_ = Type::Offset;
+	offset_ = offset;
+	angle_ = angle;
+}
+
+QString PathVariant::typeToName(Type type)
+{
+	QString ret;
+
+	switch (type) {
+	case Type::Mirror:
+		ret = "mirror";
+		break;
+	case Type::Rotate:
+		ret = "rotate";
+		break;
+	case Type::Offset:
+		ret = "offset";
+		break;
+	}
+
+	return ret;
+}
+
+bool PathVariant::nameToType(const QString& name, Type& type)
+{
+	for (Type t : { Type::Mirror, Type::Rotate, Type::Offset }) {
+		if (typeToName(t) == name) {
+			type = t;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+QString PathVariant::description() const
+{
+	QString ret;
+
+	switch (type_) {
+	case Type::Mirror:
+		ret = "mirrored";
+		break;
+	case Type::Rotate:
+		ret = "rotated 180 degrees";
+		break;
+	case Type::Offset:
+		ret = "offset by (" + QString::number(offset_.getX()) + ", " + QString::number(offset_.getY()) + "), rotated " + QString::number(angle_) + " degrees";
+		break;
+	}
+
+	return ret;
+}
+
+void PathVariant::convert(const QString& from, const QString& to)
+{
+	double scale = UnitConverter::convert(1.0, from, to);
+	field_size_ = field_size_.scale(scale);
+	offset_ = offset_.scale(scale);
+}
+
+//
+// Mirroring swaps the left and right sides of the robot, so each trajectory for a side
+// is written as the one for the other side
+//
+QString PathVariant::trajectoryName(const QString& name) const
+{
+	if (type_ != Type::Mirror)
+		return name;
+
+	const char* swapped[][2] =
+	{
+		{ TrajectoryName::Left, TrajectoryName::Right },
+		{ TrajectoryName::FL, TrajectoryName::FR },
+		{ TrajectoryName::BL, TrajectoryName::BR },
+	};
+
+	for (const auto& pair : swapped) {
+		if (name == pair[0])
+			return pair[1];
+		if (name == pair[1])
+			return pair[0];
+	}
+
+	return name;
+}
+
+Pose2dWithTrajectory PathVariant::transform(const Pose2dWithTrajectory& pt) const
+{
+	const Rotation2d& heading = pt.rotation();
+	const Rotation2d& swrot = pt.swrot();
+	double curvature = pt.curvature();
+	double dcurvature = pt.pose().dcurvature();
+	double rotvel = pt.rotVel();
+	double swrotvel = pt.pose().getSwrotVelocity();
+
+	Translation2d pos;
+	Rotation2d newheading;
+	Rotation2d newswrot;
+
+	switch (type_) {
+	case Type::Mirror:
+		//
+		// A mirror image turns the other way, so the curvature and the rotational
+		// velocities change sign
+		//
+		pos = Translation2d(field_size_.getX() - pt.x(), pt.y());
+		newheading = Rotation2d(-heading.getCos(), heading.getSin(), false);
+		newswrot = Rotation2d(-swrot.getCos(), swrot.getSin(), false);
+		curvature = -curvature;
+		dcurvature = -dcurvature;
+		rotvel = -rotvel;
+		swrotvel = -swrotvel;
+		break;
+
+	case Type::Rotate:
+		pos = Translation2d(field_size_.getX() - pt.x(), field_size_.getY() - pt.y());
+		newheading = Rotation2d(-heading.getCos(), -heading.getSin(), false);
+		newswrot = Rotation2d(-swrot.getCos(), -swrot.getSin(), false);
+		break;
+
+	case Type::Offset:
+		{
+			Rotation2d rot = Rotation2d::fromDegrees(angle_);
+			pos = pt.translation().rotateBy(rot).translateBy(offset_);
+			newheading = heading.rotateBy(rot);
+			newswrot = swrot.rotateBy(rot);
+		}
+		break;
+	}
+
+	Pose2dWithRotation pose(pos, newheading, newswrot, curvature, dcurvature);
+	pose.setRotVelocity(swrotvel);
+
+	Pose2dWithTrajectory ret(pose, pt.time(), pt.position(), pt.velocity(), pt.acceleration());
+	ret.setRotVel(rotvel);
+	return ret;
+}
+
+std::shared_ptr<TrajectoryGroup> PathVariant::transform(std::shared_ptr<TrajectoryGroup> group) const
+{
+	auto ret = std::make_shared<TrajectoryGroup>(group->type(), group->path());
+	ret->setSnapshot(group->snapshot());
+	ret->setTimestep(group->timestep());
+	ret->setErrorMessage(group->errorMessage());
+
+	for (const QString& name : group->trajectoryNames()) {
+		auto traj = group->getTrajectory(name);
+
+		QVector<Pose2dWithTrajectory> pts;
+		pts.reserve(traj->size());
+		for (const Pose2dWithTrajectory& pt : *traj) {
+			pts.push_back(transform(pt));
+		}
+
+		ret->addTrajectory(std::make_shared<PathTrajectory>(trajectoryName(name), pts));
+	}
+
+	return ret;
+}
+
+QJsonObject PathVariant::toJSONObject() const
+{
+	QJsonObject obj;
+
+	obj.insert(NameTag, name_);
+	obj.insert(TypeTag, typeToName(type_));
+
+	if (type_ == Type::Offset) {
+		obj.insert(XTag, offset_.getX());
+		obj.insert(YTag, offset_.getY());
+		obj.insert(AngleTag, angle_);
+	}
+	else {
+		obj.insert(FieldLengthTag, field_size_.getX());
+		obj.insert(FieldWidthTag, field_size_.getY());
+	}
+
+	return obj;
+}
+
+bool PathVariant::fromJSONObject(const QJsonObject& obj, PathVariant& variant, QString& msg)
+{
+	if (!obj.contains(NameTag) || !obj.value(NameTag).isString()) {
+		msg = "variant is missing a '" + QString(NameTag) + "' string value";
+		return false;
+	}
+
+	Type type;
+	if (!obj.contains(TypeTag) || !nameToType(obj.value(TypeTag).toString(), type)) {
+		msg = "variant '" + obj.value(NameTag).toString() + "' does not have a valid '" + QString(TypeTag) + "' value";
+		return false;
+	}
+
+	const char* required[] = { FieldLengthTag, FieldWidthTag };
+	if (type != Type::Offset) {
+		for (const char* tag : required) {
+			if (!obj.value(tag).isDouble()) {
+				msg = "variant '" + obj.value(NameTag).toString() + "' is missing a '" + QString(tag) + "' value";
+				return false;
+			}
+		}
+	}
+
+	variant.name_ = obj.value(NameTag).toString();
+	variant.type_ = type;
+	variant.field_size_ = Translation2d(obj.value(FieldLengthTag).toDouble(), obj.value(FieldWidthTag).toDouble());
+	variant.offset_ = Translation2d(obj.value(XTag).toDouble(), obj.value(YTag).toDouble());
+	variant.angle_ = obj.value(AngleTag).toDouble();
+
+	return true;
+}
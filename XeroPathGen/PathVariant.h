@@ -0,0 +1,113 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "Pose2dWithTrajectory.h"
+#include "Translation2d.h"
+#include <QtCore/QString>
+#include <QtCore/QJsonObject>
+#include <memory>
+
+class TrajectoryGroup;
+
+//
+// A variant is a copy of every path in a path group moved to another place on the
+// field, e.g. the red alliance copy of a blue alliance auto mode.  A variant is made
+// by transforming the generated trajectories of a path, the path is never generated
+// again for it.  Each variant is written next to the path with its name as a suffix.
+//
+class PathVariant
+{
+public:
+	enum class Type : int
+	{
+		Mirror,							// Mirrored about the centerline of the field, across its length
+		Rotate,							// Rotated 180 degrees about the center of the field
+		Offset,							// Rotated about the origin, then moved by an offset
+	};
+
+	static constexpr const char* NameTag = "name";
+	static constexpr const char* TypeTag = "type";
+	static constexpr const char* FieldLengthTag = "fieldlength";
+	static constexpr const char* FieldWidthTag = "fieldwidth";
+	static constexpr const char* XTag = "x";
+	static constexpr const char* YTag = "y";
+	static constexpr const char* AngleTag = "angle";
+
+public:
+	PathVariant();
+	PathVariant(const QString& name, Type type, const Translation2d& fieldsize);
+	PathVariant(const QString& name, const Translation2d& offset, double angle);
+
+	const QString& name() const {
+		return name_;
+	}
+
+	Type type() const {
+		return type_;
+	}
+
+	//
+	// The size of the field the variant is mirrored or rotated on, in the units of the paths
+	//
+	const Translation2d& fieldSize() const {
+		return field_size_;
+	}
+
+	const Translation2d& offset() const {
+		return offset_;
+	}
+
+	//
+	// The rotation, in degrees, of an offset variant
+	//
+	double angle() const {
+		return angle_;
+	}
+
+	//
+	// The suffix added to the path name in the names of the files written for the variant
+	//
+	QString suffix() const {
+		return "_" + name_;
+	}
+
+	QString description() const;
+
+	void convert(const QString& from, const QString& to);
+
+	//
+	// Create a new group holding the trajectories of a group transformed to this variant
+	//
+	std::shared_ptr<TrajectoryGroup> transform(std::shared_ptr<TrajectoryGroup> group) const;
+
+	QJsonObject toJSONObject() const;
+	static bool fromJSONObject(const QJsonObject& obj, PathVariant& variant, QString& msg);
+
+	static QString typeToName(Type type);
+	static bool nameToType(const QString& name, Type& type);
+
+private:
+	Pose2dWithTrajectory transform(const Pose2dWithTrajectory& pt) const;
+	QString trajectoryName(const QString& name) const;
+
+private:
+	QString name_;
+	Type type_;
+	Translation2d field_size_;
+	Translation2d offset_;
+	double angle_;
+};
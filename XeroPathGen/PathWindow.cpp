@@ -186,6 +186,31 @@ void PathWindow::prepareCustomMenu(const QPoint& pos)
 		act = new QAction(tr("Delete Group"));
 		connect(act, &QAction::triggered, this, &PathWindow::deleteGroup);
 		menu.addAction(act);
+
+		QMenu* varmenu = menu.addMenu(tr("Variants"));
+
+		act = new QAction(tr("Add Mirrored Variant"));
+		connect(act, &QAction::triggered, this, [this]() { addVariant(PathVariant::Type::Mirror); });
+		varmenu->addAction(act);
+
+		act = new QAction(tr("Add Rotated Variant"));
+		connect(act, &QAction::triggered, this, [this]() { addVariant(PathVariant::Type::Rotate); });
+		varmenu->addAction(act);
+
+		act = new QAction(tr("Add Offset Variant"));
+		connect(act, &QAction::triggered, this, [this]() { addVariant(PathVariant::Type::Offset); });
+		varmenu->addAction(act);
+
+		const PathGroup* pathgroup = model_.getPathGroupByName(menuItem_->text(0));
+		if (pathgroup != nullptr && pathgroup->variants().size() > 0) {
+			varmenu->addSeparator();
+			for (const PathVariant& variant : pathgroup->variants()) {
+				QString name = variant.name();
+				act = new QAction(tr("Remove") + " '" + name + "' (" + variant.description() + ")");
+				connect(act, &QAction::triggered, this, [this, name]() { removeVariant(name); });
+				varmenu->addAction(act);
+			}
+		}
 	}
 	else {
 		//
@@ -216,6 +241,28 @@ void PathWindow::prepareCustomMenu(const QPoint& pos)
 		connect(act, &QAction::triggered, [this, desc]() { model_.setGeneratorType(desc.type_); });
 	}
 
+	QMenu* resmenu = menu.addMenu("Resolution");
+	QActionGroup* resgroup = new QActionGroup(this);
+	for (const ResolutionDescriptor& desc : getResolutionPresets()) {
+		act = new QAction(desc.desc_);
+		resmenu->addAction(act);
+		resgroup->addAction(act);
+		act->setCheckable(true);
+
+		if (desc.preset_ == model_.resolutionPreset()) {
+			act->setChecked(true);
+		}
+
+		connect(act, &QAction::triggered, [this, desc]() { model_.setResolution(desc.preset_, model_.isAdaptive()); });
+	}
+
+	resmenu->addSeparator();
+	act = new QAction(tr("Adaptive"));
+	resmenu->addAction(act);
+	act->setCheckable(true);
+	act->setChecked(model_.isAdaptive());
+	connect(act, &QAction::triggered, [this](bool checked) { model_.setResolution(model_.resolutionPreset(), checked); });
+
 	menu.exec(this->mapToGlobal(pos));
 	menuItem_ = nullptr;
 }
@@ -236,6 +283,89 @@ void PathWindow::changePathUnits()
 	}
 }
 
+void PathWindow::addVariant(PathVariant::Type type)
+{
+	assert(menuItem_ != nullptr);
+
+	QString grname = menuItem_->text(0);
+	const PathGroup* group = model_.getPathGroupByName(grname);
+	if (group == nullptr)
+		return;
+
+	if (type != PathVariant::Type::Offset && field_ == nullptr)
+	{
+		QMessageBox::critical(this, "No Field", "A mirrored or rotated variant needs the size of the field, select a field first");
+		return;
+	}
+
+	bool ok;
+	QString name = QInputDialog::getText(this, "New Variant", "Variant Name", QLineEdit::Normal, "", &ok);
+	if (!ok)
+		return;
+
+	bool exists = std::any_of(group->variants().begin(), group->variants().end(), [&name](const PathVariant& v) { return v.name() == name; });
+	if (name.length() == 0 || !isValidName(name) || exists)
+	{
+		QMessageBox::critical(this, "Bad Variant Name", "The variant name '" + name + "' is not valid.  It must be letters and numbers and not already used by the group.");
+		return;
+	}
+
+	PathVariant variant;
+	if (type == PathVariant::Type::Offset)
+	{
+		QString text = QInputDialog::getText(this, "Offset Variant", "X, Y (" + units_ + ") and rotation (degrees)", QLineEdit::Normal, "0, 0, 0", &ok);
+		if (!ok)
+			return;
+
+		QStringList values = text.split(",");
+		double x = 0.0, y = 0.0, angle = 0.0;
+		bool valid = (values.size() == 3);
+		if (valid)
+		{
+			bool okx, oky, oka;
+			x = values[0].trimmed().toDouble(&okx);
+			y = values[1].trimmed().toDouble(&oky);
+			angle = values[2].trimmed().toDouble(&oka);
+			valid = okx && oky && oka;
+		}
+
+		if (!valid)
+		{
+			QMessageBox::critical(this, "Bad Offset", "The offset '" + text + "' is not valid, it must be three numbers separated by commas");
+			return;
+		}
+
+		variant = PathVariant(name, Translation2d(x, y), angle);
+	}
+	else
+	{
+		variant = PathVariant(name, type, field_->getSize());
+	}
+
+	QVector<PathVariant> variants = group->variants();
+	variants.push_back(variant);
+	model_.setGroupVariants(grname, variants);
+}
+
+void PathWindow::removeVariant(const QString& name)
+{
+	assert(menuItem_ != nullptr);
+
+	QString grname = menuItem_->text(0);
+	const PathGroup* group = model_.getPathGroupByName(grname);
+	if (group == nullptr)
+		return;
+
+	QVector<PathVariant> variants;
+	for (const PathVariant& variant : group->variants()) {
+		if (variant.name() != name) {
+			variants.push_back(variant);
+		}
+	}
+
+	model_.setGroupVariants(grname, variants);
+}
+
 void PathWindow::addGroup()
 {
 	QString grname = newGroupName();
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "PathsDataModel.h"
+#include "GameField.h"
 #include <QtWidgets/QTreeWidget>
 
 class PathWindow : public QTreeWidget
@@ -34,6 +35,13 @@ public:
 		robot_ = robot;
 	}
 
+	//
+	// The field gives its size to the mirrored and rotated variants of a group
+	//
+	void setField(std::shared_ptr<GameField> field) {
+		field_ = field;
+	}
+
 	std::shared_ptr<RobotPath> selectedPath() {
 		return selected_path_;
 	}
@@ -61,6 +69,8 @@ private:
 	void addPath();
 	void deletePath();
 	void changePathUnits();
+	void addVariant(PathVariant::Type type);
+	void removeVariant(const QString& name);
 
 	QString newGroupName();
 	QString newPathName(const QString& grname);
@@ -86,6 +96,7 @@ private:
 	PathsDataModel &model_;
 	QString units_;
 	std::shared_ptr<RobotParams> robot_;
+	std::shared_ptr<GameField> field_;
 	std::shared_ptr<RobotPath> selected_path_;
 
 	QBrush unknown_;
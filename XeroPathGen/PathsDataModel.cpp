@@ -49,8 +49,11 @@ PathsDataModel::~PathsDataModel()
 void PathsDataModel::reset()
 {
 	filename_.clear();
+	export_timesteps_.clear();
+	preset_ = ResolutionPreset::Standard;
+	adaptive_ = false;
+	gen_mgr_.setResolution(preset_, adaptive_);
 	groups_.clear();
-	splines_.clear();
 	undo_stack_.clear();
 	dirty_ = false;
 }
@@ -89,6 +92,13 @@ void PathsDataModel::insertGroup(PathGroup *gr, int index)
 {
 	groups_.insert(index, gr);
 
+	//
+	// The trajectories of the paths were dropped when the group was deleted
+	//
+	for (auto path : gr->paths()) {
+		generateTrajectory(path);
+	}
+
 	setDirty();
 	emit groupAdded(gr->name());
 }
@@ -101,6 +111,10 @@ void PathsDataModel::deleteGroup(const QString& grname, bool undoentry)
 			int index = std::distance(groups_.begin(), it);
 			addUndoStackEntry(std::make_shared<UndoDeleteGroup>(*it, index, *this));
 		}
+
+		for (auto path : (*it)->paths()) {
+			gen_mgr_.removePath(path);
+		}
 		groups_.erase(it);
 	}
 
@@ -147,6 +161,22 @@ void PathsDataModel::renameGroup(const QString& oldname, const QString& newname,
 	emit groupRenamed(oldname, newname);
 }
 
+void PathsDataModel::setGroupVariants(const QString& grname, const QVector<PathVariant>& variants, bool undoentry)
+{
+	auto it = std::find_if(groups_.begin(), groups_.end(), [&grname](const PathGroup* g) { return g->name() == grname; });
+	if (it == groups_.end()) {
+		QString msg = "group '" + grname + "' does not exist";
+		throw std::runtime_error(msg.toStdString());
+	}
+
+	if (undoentry) {
+		addUndoStackEntry(std::make_shared<UndoSetGroupVariants>(grname, (*it)->variants(), *this));
+	}
+
+	(*it)->setVariants(variants);
+	setDirty();
+}
+
 bool PathsDataModel::hasPath(const QString& grname, const QString& pathname) const
 {
 	bool ret = false;
@@ -270,7 +300,10 @@ void PathsDataModel::beforePathChanged(std::shared_ptr<UndoAction> undo)
 void PathsDataModel::afterPathChanged(const QString& grname, const QString& pathname)
 {
 	setDirty();
-	computeSplines(grname, pathname);
+	auto path = getPathByName(grname, pathname);
+	assert(path != nullptr);
+
+	generateTrajectory(path);
 }
 
 void PathsDataModel::enableGeneration(bool b)
@@ -281,6 +314,7 @@ void PathsDataModel::enableGeneration(bool b)
 		for (auto path : deferred_) {
 			gen_mgr_.addPath(gen_type_, path);
 		}
+		deferred_.clear();
 	}
 	else
 	{
@@ -288,48 +322,27 @@ void PathsDataModel::enableGeneration(bool b)
 	}
 }
 
-void PathsDataModel::generateTrajectory(std::shared_ptr<RobotPath> path)
+void PathsDataModel::generatePreview(std::shared_ptr<RobotPath> path)
 {
-	if (generation_enabled_) {
-		gen_mgr_.addPath(gen_type_, path);
-	}
-	else {
+	if (!deferred_.contains(path)) {
 		deferred_.push_back(path);
 	}
+	gen_mgr_.addPath(gen_type_, path, true);
 }
 
-void PathsDataModel::computeSplines(const QString& grname, const QString& pathname)
-{
-	auto path = getPathByName(grname, pathname);
-	assert(path != nullptr);
-
-	generateTrajectory(path);
-	computeSplinesForPath(path);
-	distances_.remove(path);
-}
-
-void PathsDataModel::computeSplinesForPath(std::shared_ptr<RobotPath> path)
+void PathsDataModel::generateTrajectory(std::shared_ptr<RobotPath> path)
 {
-	QVector<std::shared_ptr<SplinePair>> splines;
-
-	for (int i = 0; i < path->size() - 1; i++) {
-		const Pose2dWithRotation& p1 = path->getPoint(i);
-		const Pose2dWithRotation& p2 = path->getPoint(i + 1);
-		auto pair = std::make_shared<SplinePair>(p1, p2);
-		splines.push_back(pair);
+	if (generation_enabled_) {
+		gen_mgr_.addPath(gen_type_, path);
+	}
+	else if (!deferred_.contains(path)) {
+		deferred_.push_back(path);
 	}
-
-	splines_.insert(path, splines);
 }
 
-QVector<std::shared_ptr<SplinePair>> PathsDataModel::getSplinesForPath(std::shared_ptr<RobotPath> path)
+std::shared_ptr<const SplineSet> PathsDataModel::getSplinesForPath(std::shared_ptr<RobotPath> path)
 {
-	if (!splines_.contains(path)) {
-		computeSplinesForPath(path);
-	}
-
-	QVector<std::shared_ptr<SplinePair>> splines = splines_[path];
-	return splines;
+	return path->splines();
 }
 
 bool PathsDataModel::load(const QString& filename, QString& msg)
@@ -431,6 +444,52 @@ bool PathsDataModel::load(const QString& filename, QString& msg)
 		}
 	}
 
+	if (obj.contains(RobotPath::ExportTimestepsTag))
+	{
+		QJsonValue vobj = obj[RobotPath::ExportTimestepsTag];
+		if (!vobj.isArray())
+		{
+			msg = "JSON file '" + file.fileName() + "' has '" + RobotPath::ExportTimestepsTag + "' value that is not an array";
+			return false;
+		}
+
+		for (const QJsonValue& v : vobj.toArray())
+		{
+			if (!v.isDouble() || v.toDouble() <= 0.0)
+			{
+				msg = "JSON file '" + file.fileName() + "' has '" + RobotPath::ExportTimestepsTag + "' entry that is not a positive number";
+				return false;
+			}
+			export_timesteps_.push_back(v.toDouble());
+		}
+	}
+
+	if (obj.contains(RobotPath::ResolutionTag))
+	{
+		QJsonValue vobj = obj[RobotPath::ResolutionTag];
+		if (!vobj.isString() || !keyToPreset(vobj.toString(), preset_))
+		{
+			msg = "JSON file '" + file.fileName() + "' has '" + RobotPath::ResolutionTag + "' value that is not a known resolution";
+			return false;
+		}
+	}
+
+	if (obj.contains(RobotPath::AdaptiveResolutionTag))
+	{
+		QJsonValue vobj = obj[RobotPath::AdaptiveResolutionTag];
+		if (!vobj.isBool())
+		{
+			msg = "JSON file '" + file.fileName() + "' has '" + RobotPath::AdaptiveResolutionTag + "' value that is not a boolean";
+			return false;
+		}
+		adaptive_ = vobj.toBool();
+	}
+
+	//
+	// The resolution is set before the groups are read, as reading a path may generate it
+	//
+	gen_mgr_.setResolution(preset_, adaptive_);
+
 	if (!obj.contains(RobotPath::GroupsTag))
 	{
 		msg = "JSON file '" + file.fileName() + "' does not contain '" + RobotPath::GroupsTag + "'array";
@@ -505,6 +564,30 @@ bool PathsDataModel::readPathGroup(QFile& file, const QJsonObject& obj, QString
 		addPath(path, false);
 	}
 
+	if (obj.contains(RobotPath::VariantsTag))
+	{
+		val = obj[RobotPath::VariantsTag];
+		if (!val.isArray())
+		{
+			msg = "JSON file '" + file.fileName() + "', object in 'groups' array has 'variants' value, but its not an array";
+			return false;
+		}
+
+		QVector<PathVariant> variants;
+		for (const QJsonValue& v : val.toArray())
+		{
+			PathVariant variant;
+			if (!v.isObject() || !PathVariant::fromJSONObject(v.toObject(), variant, msg))
+			{
+				msg = "JSON file '" + file.fileName() + "', group '" + name + "' has an invalid variant - " + msg;
+				return false;
+			}
+			variants.push_back(variant);
+		}
+
+		setGroupVariants(name, variants, false);
+	}
+
 	return true;
 }
 
@@ -556,6 +639,14 @@ QJsonObject PathsDataModel::modelToObject()
 		grobj.insert(RobotPath::NameTag, gr->name());
 		grobj.insert(RobotPath::PathsTag, patharray);
 
+		if (gr->variants().size() > 0) {
+			QJsonArray variants;
+			for (const PathVariant& variant : gr->variants()) {
+				variants.append(variant.toJSONObject());
+			}
+			grobj.insert(RobotPath::VariantsTag, variants);
+		}
+
 		a.append(grobj);
 	}
 
@@ -563,6 +654,17 @@ QJsonObject PathsDataModel::modelToObject()
 	obj[RobotPath::UnitsTag] = units_;
 	obj[RobotPath::GeneratorTag] = typeToKey(gen_type_);
 	obj[RobotPath::OutputTag] = path_output_dir_;
+	obj[RobotPath::ResolutionTag] = presetToKey(preset_);
+	obj[RobotPath::AdaptiveResolutionTag] = adaptive_;
+
+	if (export_timesteps_.size() > 0) {
+		QJsonArray steps;
+		for (double step : export_timesteps_) {
+			steps.append(step);
+		}
+		obj[RobotPath::ExportTimestepsTag] = steps;
+	}
+
 	obj[RobotPath::GroupsTag] = a;
 
 	return obj;
@@ -571,27 +673,37 @@ QJsonObject PathsDataModel::modelToObject()
 void PathsDataModel::convert(const QString& units)
 {
 	if (units != units_) {
+		//
+		// A change of units only scales the lengths of the paths.  The paths are
+		// converted with their signals blocked so they are not generated again, and
+		// the generated trajectories are scaled to match.  The paths make their
+		// splines again from the converted waypoints.
+		//
+		QVector<std::shared_ptr<RobotPath>> paths = getAllPaths();
+
 		for (auto gr : groups_) {
-			for (auto path : gr->paths()) {
-				path->convert(units_, units);
-			}
+			gr->convert(units_, units);
 		}
 
-		distances_.clear();
-		splines_.clear();
+		for (auto path : paths) {
+			bool blocked = path->blockSignals(true);
+			path->convert(units_, units);
+			path->blockSignals(blocked);
+			path->takeChangedAt();
+		}
+
+		gen_mgr_.convertPaths(paths);
+
+		if (paths.size() > 0) {
+			setDirty();
+		}
 		units_ = units;
 	}
 }
 
 QVector<double> PathsDataModel::getDistancesForPath(std::shared_ptr<RobotPath> path)
 {
-	if (!distances_.contains(path))
-	{
-		QVector<std::shared_ptr<SplinePair>> splines = getSplinesForPath(path);
-		auto dists = TrajectoryUtils::getDistancesForSplines(splines);
-		distances_.insert(path, dists);
-	}
-	return distances_.value(path);
+	return path->splines()->distances();
 }
 
 void PathsDataModel::addUndoStackEntry(std::shared_ptr<UndoAction> undo)
@@ -18,9 +18,12 @@
 #include "GenerationMgr.h"
 #include "GeneratorType.h"
 #include "PathGroup.h"
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "UndoSetGeneratorType.h"
 #include "UndoSetUnits.h"
+#include "UndoSetGroupVariants.h"
+#include "UndoSetResolution.h"
+#include "ResolutionPreset.h"
 #include <QtCore/QObject>
 #include <QtCore/QList>
 #include <QtCore/QFile>
@@ -40,6 +43,12 @@ public:
 
 	void enableGeneration(bool);
 
+	//
+	// Queue a preview generation of a path while generation is disabled for a drag.  The
+	// full generation of the path still happens when generation is enabled again.
+	//
+	void generatePreview(std::shared_ptr<RobotPath> path);
+
 	void setGeneratorType(GeneratorType type, bool undoentry = true) {
 		if (undoentry) {
 			auto undo = std::make_shared<UndoSetGeneratorType>(gen_type_, *this);
@@ -54,6 +63,30 @@ public:
 		return gen_type_;
 	}
 
+	//
+	// The resolution the paths of the project are generated at, which is given to the
+	// generation manager as it changes
+	//
+	void setResolution(ResolutionPreset preset, bool adaptive, bool undoentry = true) {
+		if (undoentry) {
+			auto undo = std::make_shared<UndoSetResolution>(preset_, adaptive_, *this);
+			addUndoStackEntry(undo);
+		}
+		preset_ = preset;
+		adaptive_ = adaptive;
+		gen_mgr_.setResolution(preset_, adaptive_);
+		dirty_ = true;
+		emit resolutionChanged();
+	}
+
+	ResolutionPreset resolutionPreset() const {
+		return preset_;
+	}
+
+	bool isAdaptive() const {
+		return adaptive_;
+	}
+
 	void reset();
 
 	const QString& units() const {
@@ -101,6 +134,15 @@ public:
 		path_output_dir_ = dir;
 	}
 
+	const QVector<double>& exportTimesteps() const {
+		return export_timesteps_;
+	}
+
+	void setExportTimesteps(const QVector<double>& steps) {
+		export_timesteps_ = steps;
+		setDirty();
+	}
+
 	bool save(QString &msg);
 	bool saveToFile(const QString& filename, QString& msg);
 	bool saveAs(const QString& filename, QString &msg);
@@ -115,6 +157,7 @@ public:
 	QStringList groupNames() const ;
 	const PathGroup* getPathGroupByName(const QString& grname);
 	void renameGroup(const QString& oldname, const QString& newname, bool undoentry = true);
+	void setGroupVariants(const QString& grname, const QVector<PathVariant>& variants, bool undoentry = true);
 
 	bool hasPath(const QString& grname, const QString& pathname) const;
 	void addPath(std::shared_ptr<RobotPath> path, bool undoentry = true);
@@ -124,7 +167,7 @@ public:
 	std::shared_ptr<RobotPath> getPathByName(const QString& grname, const QString& pathname);
 	void renamePath(const QString &grname, const QString& oldname, const QString& newname, bool undoentry = true);
 
-	QVector<std::shared_ptr<SplinePair>> getSplinesForPath(std::shared_ptr<RobotPath> path);
+	std::shared_ptr<const SplineSet> getSplinesForPath(std::shared_ptr<RobotPath> path);
 	QVector<double> getDistancesForPath(std::shared_ptr<RobotPath> path);
 
 	QVector<std::shared_ptr<RobotPath>> getAllPaths();
@@ -132,9 +175,6 @@ public:
 	std::shared_ptr<UndoAction> popUndoStack();
 
 private:
-	void computeSplinesForPath(std::shared_ptr<RobotPath> path);
-	void computeSplines(const QString &grname, const QString &pathname);
-
 	bool readPathGroup(QFile& file, const QJsonObject& obj, QString &msg);
 
 	void generateTrajectory(std::shared_ptr<RobotPath> path);
@@ -159,24 +199,22 @@ signals:
 	void pathRenamed(const QString &grname, const QString& oldname, const QString& newname);
 	void unitsChanged(const QString& units);
 	void trajectoryGeneratorChanged();
+	void resolutionChanged();
 
 private:
 	QString filename_;						// The filename for the path JSON file
 	QString path_output_dir_;				// The directory for the output of trajectory (.csv) files
+	QVector<double> export_timesteps_;		// Additional timesteps to resample trajectories to when writing output files
 	QString units_;							// The units for the current data model
 	QList<PathGroup *> groups_;				// The path groups (auto modes) that are stored here
 	GeneratorType gen_type_;				// The generator type that goes with these paths
+	ResolutionPreset preset_;				// The resolution the paths are generated at
+	bool adaptive_;							// If true, the resolution adapts to the curvature and rotation of the paths
 
 	GenerationMgr& gen_mgr_;				// The generator manager to actually do the work of generating trajectories
 	bool dirty_;							// If true, unsaved changes exist
 	QString default_units_;					// The units to use if a data file being read does not have units
 
-	// A mapping of paths to splines
-	QMap<std::shared_ptr<RobotPath>, QVector<std::shared_ptr<SplinePair>>> splines_;
-
-	// A mapping of paths to distances
-	QMap<std::shared_ptr<RobotPath>, QVector<double>> distances_;
-
 	QVector<std::shared_ptr<RobotPath>> deferred_;
 	bool generation_enabled_;
 
@@ -19,49 +19,57 @@
 Pose2dWithRotation::Pose2dWithRotation()
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(double x, double y) : Pose2d(x, y)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(double x, double y, const Rotation2d& rot) : Pose2d(x, y, rot)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(const Translation2d& pos) : Pose2d(pos)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(const Rotation2d& rot) : Pose2d(rot)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot) : Pose2d(pos, rot)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
-Pose2dWithRotation::Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot, const Rotation2d& swrot, double cur) : Pose2d(pos, rot)
+Pose2dWithRotation::Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot, const Rotation2d& swrot, double cur, double dcur) : Pose2d(pos, rot)
 {
 	swrot_ = swrot;
 	curvature_ = cur;
+	dcurvature_ = dcur;
 	rotvel_ = 0.0;
 }
 
 Pose2dWithRotation::Pose2dWithRotation(const Pose2d& other) : Pose2d(other)
 {
 	curvature_ = 0.0;
+	dcurvature_ = 0.0;
 	rotvel_ = 0.0;
 }
 
@@ -69,7 +77,8 @@ Pose2dWithRotation::Pose2dWithRotation(const Pose2dWithRotation& other) : Pose2d
 {
 	swrot_ = other.swrot_;
 	rotvel_ = other.rotvel_;
-	curvature_ = 0.0;
+	curvature_ = other.curvature_;
+	dcurvature_ = other.dcurvature_;
 }
 
 Pose2dWithRotation::~Pose2dWithRotation()
@@ -82,6 +91,7 @@ Pose2dWithRotation Pose2dWithRotation::interpolate(const Pose2dWithRotation& oth
 	Rotation2d r2d = getRotation().interpolate(other.getRotation(), percent);
 	Rotation2d sw = getSwrot().interpolate(other.getSwrot(), percent);
 	double ncurv = (other.curvature() - curvature()) * percent + curvature();
+	double ndcurv = (other.dcurvature() - dcurvature()) * percent + dcurvature();
 
-	return Pose2dWithRotation(t2d, r2d, sw, ncurv);
+	return Pose2dWithRotation(t2d, r2d, sw, ncurv, ndcurv);
 }
\ No newline at end of file
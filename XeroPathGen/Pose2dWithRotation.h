@@ -26,7 +26,7 @@ public:
 	Pose2dWithRotation(const Translation2d& pos);
 	Pose2dWithRotation(const Rotation2d& pos);
 	Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot);
-	Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot, const Rotation2d& swrot, double cur = 0.0);
+	Pose2dWithRotation(const Translation2d& pos, const Rotation2d& rot, const Rotation2d& swrot, double cur = 0.0, double dcur = 0.0);
 	Pose2dWithRotation(const Pose2d& other);
 	Pose2dWithRotation(const Pose2dWithRotation& other);
 	virtual ~Pose2dWithRotation();
@@ -57,6 +57,17 @@ public:
 		return curvature_;
 	}
 
+	//
+	// The rate of change of the curvature with distance along the path
+	//
+	void setDCurvature(double d) {
+		dcurvature_ = d;
+	}
+
+	double dcurvature() const {
+		return dcurvature_;
+	}
+
 	static double triangleArea(const Pose2dWithRotation& a, const Pose2dWithRotation& b, const Pose2dWithRotation& c)
 	{
 		return ((b.getTranslation().getX() - a.getTranslation().getX()) * (c.getTranslation().getY() - a.getTranslation().getY())) -
@@ -78,5 +89,6 @@ private:
 	Rotation2d swrot_;				// The rotation at a given waypoint
 	double rotvel_;					// The rotational velocity at a given waypoint
 	double curvature_;				// The computed curvature at a given waypoint
+	double dcurvature_;				// The change in curvature per unit of distance at a given waypoint
 };
 
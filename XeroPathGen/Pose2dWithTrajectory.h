@@ -26,6 +26,7 @@ public:
 		position_ = 0.0;
 		velocity_ = 0.0;
 		acceleration_ = 0.0;
+		rotvel_ = 0.0;
 	}
 
 	Pose2dWithTrajectory(const Pose2dWithRotation& pose, double time, double pos, double vel, double acc) {
@@ -34,6 +35,7 @@ public:
 		position_ = pos;
 		velocity_ = vel;
 		acceleration_ = acc;
+		rotvel_ = 0.0;
 	}
 
 	virtual ~Pose2dWithTrajectory() {
@@ -111,6 +113,19 @@ public:
 		return rotvel_;
 	}
 
+	//
+	// Multiplies every length of this point by a factor, e.g. to change its units
+	//
+	void scale(double s) {
+		Pose2dWithRotation pose(pose_.getTranslation().scale(s), pose_.getRotation(), pose_.getSwrot(), pose_.curvature() / s, pose_.dcurvature() / (s * s));
+		pose.setRotVelocity(pose_.getSwrotVelocity());
+		pose_ = pose;
+
+		position_ *= s;
+		velocity_ *= s;
+		acceleration_ *= s;
+	}
+
 	double getField(const QString& field) const;
 
 	Pose2dWithTrajectory interpolate(const Pose2dWithTrajectory& other, double percent) const;
@@ -27,6 +27,21 @@ QuinticHermiteSpline::QuinticHermiteSpline(double v0, double v1, double dv0, dou
 	compute();
 }
 
+//
+// The coefficients are linear in the end values and derivatives, so scaling them all
+// scales the spline by the same factor
+//
+void QuinticHermiteSpline::scale(double s)
+{
+	v0_ *= s;
+	v1_ *= s;
+	dv0_ *= s;
+	dv1_ *= s;
+	ddv0_ *= s;
+	ddv1_ *= s;
+	compute();
+}
+
 void QuinticHermiteSpline::compute()
 {
 	a_ = -6 * v0_ - 3 * dv0_ - 0.5 * ddv0_ + 0.5 * ddv1_ - 3 * dv1_ + 6 * v1_;
@@ -37,22 +52,22 @@ void QuinticHermiteSpline::compute()
 	f_ = v0_;
 }
 
-double QuinticHermiteSpline::eval(double t)
+double QuinticHermiteSpline::eval(double t) const
 {
 	return a() * t * t * t * t * t + b() * t * t * t * t + c() * t * t * t + d() * t * t + e() * t + f();
 }
 
-double QuinticHermiteSpline::derivative(double t)
+double QuinticHermiteSpline::derivative(double t) const
 {
 	return 5 * a() * t * t * t * t + 4 * b() * t * t * t + 3 * c() * t * t + 2 * d() * t + e();
 }
 
-double QuinticHermiteSpline::derivative2(double t)
+double QuinticHermiteSpline::derivative2(double t) const
 {
 	return 20 * a() * t * t * t + 12 * b() * t * t + 6 * c() * t + 2 * d();
 }
 
-double QuinticHermiteSpline::derivative3(double t)
+double QuinticHermiteSpline::derivative3(double t) const
 {
 	return 60 * a() * t * t + 24 * b() * t + 6 * c();
 }
@@ -21,26 +21,27 @@ class QuinticHermiteSpline
 public:
 	QuinticHermiteSpline(double v0, double v1, double dv0, double dv1, double ddv0, double ddv1);
 
-	double eval(double t);
-	double derivative(double t);
-	double derivative2(double t);
-	double derivative3(double t);
+	double eval(double t) const;
+	double derivative(double t) const;
+	double derivative2(double t) const;
+	double derivative3(double t) const;
 
-	double v0() { return v0_; }
-	double v1() { return v1_; }
-	double dv0() { return dv0_; }
-	double dv1() { return dv1_; }
-	double ddv0() { return ddv0_; }
-	double ddv1() { return ddv1_; }
+	double v0() const { return v0_; }
+	double v1() const { return v1_; }
+	double dv0() const { return dv0_; }
+	double dv1() const { return dv1_; }
+	double ddv0() const { return ddv0_; }
+	double ddv1() const { return ddv1_; }
 
 	void ddv0(double v) { ddv0_ = v; compute(); }
 	void ddv1(double v) { ddv1_ = v; compute(); }
-	double a() { return a_; }
-	double b() { return b_; }
-	double c() { return c_; }
-	double d() { return d_; }
-	double e() { return e_; }
-	double f() { return f_; }
+	void scale(double s);
+	double a() const { return a_; }
+	double b() const { return b_; }
+	double c() const { return c_; }
+	double d() const { return d_; }
+	double e() const { return e_; }
+	double f() const { return f_; }
 
 private:
 	void compute();
@@ -0,0 +1,81 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+//
+// How finely a project's paths are generated.  Each preset has a fixed and an
+// adaptive resolution, see Generator::resolution().
+//
+enum class ResolutionPreset
+{
+	Draft,
+	Standard,
+	Precise
+};
+
+struct ResolutionDescriptor
+{
+	QString jsonKey_;
+	QString desc_;
+	ResolutionPreset preset_;
+
+	ResolutionDescriptor(ResolutionPreset preset, const QString& key, const QString& desc) {
+		preset_ = preset;
+		jsonKey_ = key;
+		desc_ = desc;
+	}
+};
+
+inline QVector<ResolutionDescriptor> getResolutionPresets()
+{
+	QVector<ResolutionDescriptor> ret;
+
+	ret.push_back(ResolutionDescriptor(ResolutionPreset::Draft, "draft", "Draft"));
+	ret.push_back(ResolutionDescriptor(ResolutionPreset::Standard, "standard", "Standard"));
+	ret.push_back(ResolutionDescriptor(ResolutionPreset::Precise, "precise", "Precise"));
+
+	return ret;
+}
+
+inline bool keyToPreset(const QString& key, ResolutionPreset& preset)
+{
+	for (const auto& desc : getResolutionPresets())
+	{
+		if (desc.jsonKey_ == key)
+		{
+			preset = desc.preset_;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline QString presetToKey(ResolutionPreset preset)
+{
+	for (const auto& desc : getResolutionPresets())
+	{
+		if (desc.preset_ == preset)
+		{
+			return desc.jsonKey_;
+		}
+	}
+
+	return "";
+}
@@ -294,13 +294,23 @@ std::shared_ptr<RobotParams> RobotManager::load(QFile& file)
 
 bool RobotManager::save(std::shared_ptr<RobotParams> robot, QFile &file)
 {
-	QJsonObject obj;
 	QFileInfo info(file);
 	QDir dir = info.absoluteDir();
 
 	if (!dir.exists())
 		dir.mkpath(dir.path());
 
+	QJsonDocument doc(toJSONObject(robot));
+	file.open(QFile::WriteOnly);
+	file.write(doc.toJson());
+	file.close();
+	return true;
+}
+
+QJsonObject RobotManager::toJSONObject(std::shared_ptr<RobotParams> robot)
+{
+	QJsonObject obj;
+
 	obj[RobotParams::VersionTag] = "1";
 	obj[RobotParams::NameTag] = robot->getName();
 	obj[RobotParams::DriveTypeTag] = static_cast<int>(robot->getDriveType());
@@ -315,9 +325,57 @@ bool RobotManager::save(std::shared_ptr<RobotParams> robot, QFile &file)
 	obj[RobotParams::LengthUnitsTag] = robot->getLengthUnits();
 	obj[RobotParams::WeightUnitsTag] = robot->getWeightUnits();
 
-	QJsonDocument doc(obj);
-	file.open(QFile::WriteOnly);
-	file.write(doc.toJson());
-	file.close();
-	return true;
+	return obj;
+}
+
+std::shared_ptr<RobotParams> RobotManager::fromJSONObject(const QJsonObject& obj, QString& msg)
+{
+	const char* numbers[] =
+	{
+		RobotParams::DriveTypeTag,
+		RobotParams::TimeStepTag,
+		RobotParams::EffectiveWidthTag,
+		RobotParams::EffectiveLengthTag,
+		RobotParams::RobotWidthTag,
+		RobotParams::RobotLengthTag,
+		RobotParams::RobotWeightTag,
+		RobotParams::MaxVelocityTag,
+		RobotParams::MaxAccelerationTag,
+	};
+
+	for (const char* tag : numbers) {
+		if (!obj.value(tag).isDouble()) {
+			msg = "robot has no numeric '" + QString(tag) + "' value";
+			return nullptr;
+		}
+	}
+
+	const char* strings[] = { RobotParams::NameTag, RobotParams::LengthUnitsTag, RobotParams::WeightUnitsTag };
+	for (const char* tag : strings) {
+		if (!obj.value(tag).isString()) {
+			msg = "robot has no string '" + QString(tag) + "' value";
+			return nullptr;
+		}
+	}
+
+	int drive = obj.value(RobotParams::DriveTypeTag).toInt();
+	if (drive != static_cast<int>(RobotParams::DriveType::TankDrive) && drive != static_cast<int>(RobotParams::DriveType::SwerveDrive)) {
+		msg = "robot has an invalid drive type " + QString::number(drive);
+		return nullptr;
+	}
+
+	auto robot = std::make_shared<RobotParams>(obj.value(RobotParams::NameTag).toString());
+	robot->setDriveType(static_cast<RobotParams::DriveType>(drive));
+	robot->setTimestep(obj.value(RobotParams::TimeStepTag).toDouble());
+	robot->setWheelBaseWidth(obj.value(RobotParams::EffectiveWidthTag).toDouble());
+	robot->setWheelBaseLength(obj.value(RobotParams::EffectiveLengthTag).toDouble());
+	robot->setBumberWidth(obj.value(RobotParams::RobotWidthTag).toDouble());
+	robot->setBumberLength(obj.value(RobotParams::RobotLengthTag).toDouble());
+	robot->setRobotWeight(obj.value(RobotParams::RobotWeightTag).toDouble());
+	robot->setMaxVelocity(obj.value(RobotParams::MaxVelocityTag).toDouble());
+	robot->setMaxAcceleration(obj.value(RobotParams::MaxAccelerationTag).toDouble());
+	robot->setLengthUnits(obj.value(RobotParams::LengthUnitsTag).toString());
+	robot->setWeightUnits(obj.value(RobotParams::WeightUnitsTag).toString());
+
+	return robot;
 }
@@ -18,6 +18,7 @@
 #include "RobotParams.h"
 #include <QFile>
 #include <QFileInfo>
+#include <QJsonObject>
 #include <string>
 #include <list>
 #include <memory>
@@ -43,6 +44,12 @@ public:
 	std::shared_ptr<RobotParams> load(QFile& file);
 	static bool save(std::shared_ptr<RobotParams> robot, QFile& file);
 
+	//
+	// The robot in the same form as a robot file, for embedding in other files
+	//
+	static QJsonObject toJSONObject(std::shared_ptr<RobotParams> robot);
+	static std::shared_ptr<RobotParams> fromJSONObject(const QJsonObject& obj, QString& msg);
+
 	bool deleteRobot(const QString& name);
 
 protected:
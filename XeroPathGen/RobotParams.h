@@ -57,6 +57,27 @@ public:
 	static constexpr const char* DefaultLengthUnits = "m";
 	static constexpr const char* DefaultWeightUnits = "lbs";
 
+public:
+	//
+	// The parameters that change the trajectories generated for a path, as bits so a
+	// generation can record the set it read.  The name and file name are not here
+	// as they never change a trajectory.
+	//
+	typedef unsigned Fields;
+
+	static constexpr Fields DriveTypeField = 0x0001;
+	static constexpr Fields LengthUnitsField = 0x0002;
+	static constexpr Fields WeightUnitsField = 0x0004;
+	static constexpr Fields WheelBaseWidthField = 0x0008;
+	static constexpr Fields WheelBaseLengthField = 0x0010;
+	static constexpr Fields BumperWidthField = 0x0020;
+	static constexpr Fields BumperLengthField = 0x0040;
+	static constexpr Fields WeightField = 0x0080;
+	static constexpr Fields MaxVelocityField = 0x0100;
+	static constexpr Fields MaxAccelerationField = 0x0200;
+	static constexpr Fields TimestepField = 0x0400;
+	static constexpr Fields AllFields = 0x07ff;
+
 public:
 	RobotParams(const QString& name) {
 		name_ = name;
@@ -70,6 +91,8 @@ public:
 		length_units_ = "in";
 		weight_units_ = "lbs";
 		timestep_ = 0.02;
+		weight_ = DefaultWeight;
+		read_ = 0;
 	}
 
 	virtual ~RobotParams() {
@@ -96,6 +119,7 @@ public:
 	}
 
 	DriveType getDriveType() const {
+		read_ |= DriveTypeField;
 		return drivetype_;
 	}
 
@@ -112,10 +136,12 @@ public:
 	}
 
 	const QString& getLengthUnits() const {
+		read_ |= LengthUnitsField;
 		return length_units_;
 	}
 
 	const QString& getWeightUnits() const {
+		read_ |= WeightUnitsField;
 		return weight_units_;
 	}
 
@@ -130,6 +156,7 @@ public:
 	}
 
 	double getWheelBaseWidth() const {
+		read_ |= WheelBaseWidthField;
 		return ewidth_;
 	}
 
@@ -138,6 +165,7 @@ public:
 	}
 
 	double getWheelBaseLength() const {
+		read_ |= WheelBaseLengthField;
 		return elength_;
 	}
 
@@ -146,6 +174,7 @@ public:
 	}
 
 	double getBumberWidth() const {
+		read_ |= BumperWidthField;
 		return rwidth_;
 	}
 
@@ -154,6 +183,7 @@ public:
 	}
 
 	double getRobotWeight() const {
+		read_ |= WeightField;
 		return weight_;
 	}
 
@@ -162,6 +192,7 @@ public:
 	}
 
 	double getBumberLength() const {
+		read_ |= BumperLengthField;
 		return rlength_;
 	}
 
@@ -170,6 +201,7 @@ public:
 	}
 
 	double getMaxVelocity() const {
+		read_ |= MaxVelocityField;
 		return max_velocity_;
 	}
 
@@ -178,6 +210,7 @@ public:
 	}
 
 	double getMaxAccel() const {
+		read_ |= MaxAccelerationField;
 		return max_acceleration_;
 	}
 
@@ -186,6 +219,7 @@ public:
 	}
 
 	double getTimestep() const {
+		read_ |= TimestepField;
 		return timestep_;
 	}
 
@@ -193,7 +227,51 @@ public:
 		timestep_ = v;
 	}
 
+	//
+	// The fields read through the getters since the last call to clearFieldsRead()
+	//
+	Fields fieldsRead() const {
+		return read_;
+	}
+
+	void clearFieldsRead() {
+		read_ = 0;
+	}
+
+	//
+	// The fields that differ between this robot and another
+	//
+	Fields changedFields(const RobotParams& other) const {
+		Fields ret = 0;
+
+		if (drivetype_ != other.drivetype_)
+			ret |= DriveTypeField;
+		if (length_units_ != other.length_units_)
+			ret |= LengthUnitsField;
+		if (weight_units_ != other.weight_units_)
+			ret |= WeightUnitsField;
+		if (ewidth_ != other.ewidth_)
+			ret |= WheelBaseWidthField;
+		if (elength_ != other.elength_)
+			ret |= WheelBaseLengthField;
+		if (rwidth_ != other.rwidth_)
+			ret |= BumperWidthField;
+		if (rlength_ != other.rlength_)
+			ret |= BumperLengthField;
+		if (weight_ != other.weight_)
+			ret |= WeightField;
+		if (max_velocity_ != other.max_velocity_)
+			ret |= MaxVelocityField;
+		if (max_acceleration_ != other.max_acceleration_)
+			ret |= MaxAccelerationField;
+		if (timestep_ != other.timestep_)
+			ret |= TimestepField;
+
+		return ret;
+	}
+
 	void getLocations(const QString &units, Translation2d& fl, Translation2d& fr, Translation2d& bl, Translation2d& br) {
+		read_ |= BumperWidthField | BumperLengthField | LengthUnitsField;
 		double width = UnitConverter::convert(rwidth_, length_units_, units);
 		double length = UnitConverter::convert(rlength_, length_units_, units);
 
@@ -217,5 +295,6 @@ private:
 	DriveType drivetype_;
 	QString filename_;
 	double timestep_;
+	mutable Fields read_;
 };
 
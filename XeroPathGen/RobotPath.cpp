@@ -25,6 +25,7 @@
 #include "UndoInsertPoint.h"
 #include "UndoAddConstraint.h"
 #include "UndoDeleteConstraint.h"
+#include "Tracer.h"
 #include <QtCore/QJsonArray>
 #include <limits>
 
@@ -34,6 +35,42 @@ RobotPath::RobotPath(const PathGroup* gr, const QString& units, const QString &n
 	name_ = name;
 	params_ = params;
 	units_ = units;
+	changed_at_ = 0;
+}
+
+std::shared_ptr<RobotPath> RobotPath::snapshot() const
+{
+	auto group = std::make_shared<PathGroup>(group_->name());
+	auto ret = std::make_shared<RobotPath>(group.get(), units_, name_, params_);
+	ret->snapshot_group_ = group;
+	ret->waypoints_ = waypoints_;
+	ret->splines_ = splines();
+
+	for (auto c : constraints_) {
+		ret->constraints_.push_back(c->clone(ret));
+	}
+
+	return ret;
+}
+
+std::shared_ptr<const SplineSet> RobotPath::splines() const
+{
+	if (splines_ == nullptr) {
+		splines_ = std::make_shared<SplineSet>(waypoints_);
+	}
+
+	return splines_;
+}
+
+//
+// The splines from first to last, in the waypoints as they are now, are the only ones
+// an edit changed.  A set that has not been made yet is left to be made when needed.
+//
+void RobotPath::updateSplines(int first, int last)
+{
+	if (splines_ != nullptr) {
+		splines_ = std::make_shared<SplineSet>(*splines_, waypoints_, first, last);
+	}
 }
 
 QString RobotPath::fullname() const {
@@ -60,6 +97,7 @@ void RobotPath::replacePoint(int index, const Pose2dWithRotation& pt, bool undoe
 		emitBeforePathChangedSignal(std::make_shared<UndoChangeWaypoint>(index, waypoints_[index], shared_from_this()));
 	}
 	waypoints_[index] = pt;
+	updateSplines(index - 1, index);
 	emitAfterPathChangedSignal();
 }
 
@@ -69,6 +107,7 @@ void RobotPath::removePoint(int index, bool undoentry)
 		emitBeforePathChangedSignal(std::make_shared<UndoRemovePoint>(index, waypoints_[index], shared_from_this()));
 	}
 	waypoints_.remove(index, 1);
+	updateSplines(index - 1, index - 1);
 	emitAfterPathChangedSignal();
 
 }
@@ -79,6 +118,7 @@ void RobotPath::insertPoint(int index, const Pose2dWithRotation& pt, bool undoen
 		emitBeforePathChangedSignal(std::make_shared<UndoInsertPoint>(index + 1, shared_from_this()));
 	}
 	waypoints_.insert(index + 1, pt);
+	updateSplines(index, index + 1);
 	emitAfterPathChangedSignal();
 }
 
@@ -116,6 +156,7 @@ void RobotPath::emitBeforePathChangedSignal(std::shared_ptr<UndoAction> action)
 
 void RobotPath::emitAfterPathChangedSignal()
 {
+	changed_at_ = Tracer::now();
 	emit afterPathChanged(group_->name(), name_);
 }
 
@@ -130,6 +171,11 @@ void RobotPath::convert(const QString& from, const QString& to)
 	bool save = signalsBlocked();
 	blockSignals(true);
 
+	//
+	// Every spline changes, so they are made again once when next needed
+	//
+	splines_.reset();
+
 	for (int i = 0; i < size(); i++) {
 		const Pose2dWithRotation pt = getPoint(i);
 		double newx = UnitConverter::convert(pt.getTranslation().getX(), from, to);
@@ -18,6 +18,7 @@
 #include "Pose2dWithRotation.h"
 #include "PathConstraint.h"
 #include "PathParameters.h"
+#include "SplineSet.h"
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
@@ -42,6 +43,9 @@ public:
 	static constexpr const char* GeneratorTag = "generator";
 	static constexpr const char* TimeTag = "time";
 	static constexpr const char* OutputTag = "outdir";
+	static constexpr const char* ExportTimestepsTag = "exporttimesteps";
+	static constexpr const char* ResolutionTag = "resolution";
+	static constexpr const char* AdaptiveResolutionTag = "adaptiveresolution";
 	static constexpr const char* GroupsTag = "groups";
 	static constexpr const char* GroupTag = "group";
 	static constexpr const char* PositionTag = "position";
@@ -49,6 +53,7 @@ public:
 	static constexpr const char* AccelerationTag = "acceleration";
 	static constexpr const char* NameTag = "name";
 	static constexpr const char* PathsTag = "paths";
+	static constexpr const char* VariantsTag = "variants";
 	static constexpr const char* StartVelocityTag = "startvelocity";
 	static constexpr const char* EndVelocityTag = "endvelocity";
 	static constexpr const char* StartAngleTag = "startangle";
@@ -103,6 +108,7 @@ public:
 
 	void addWayPoint(const Pose2dWithRotation& waypoint) {
 		waypoints_.push_back(waypoint);
+		splines_.reset();
 	}
 
 	bool isEmpty() const {
@@ -136,11 +142,53 @@ public:
 		return constraints_;
 	}
 
+	//
+	// The splines through the waypoints.  They are made the first time they are asked
+	// for, and the same set is shared with any snapshot taken before the next change.
+	// An edit of one waypoint makes a new set in which only the splines next to it are
+	// made again.
+	//
+	std::shared_ptr<const SplineSet> splines() const;
+
 	void convert(const QString& from, const QString& to);
 
+	//
+	// A copy of this path for the generator threads to read while the GUI goes on
+	// editing the original, which is never changed after it is made.  The waypoints are implicitly shared and
+	// only copied if the original changes, the splines are made here on the GUI thread
+	// and shared, the constraints are cloned, and the snapshot has its own copy of the
+	// group so its full name stays valid.
+	//
+	std::shared_ptr<RobotPath> snapshot() const;
+
 	static std::shared_ptr<RobotPath> fromJSONObject(const PathGroup *group, const QString &units, const QJsonObject& obj, QString &msg);
 	QJsonObject toJSONObject();
 
+	//
+	// The time, on the Tracer clock, of the last change that has not yet been queued
+	// for generation.  Taking it resets it to zero so that regenerating the path for
+	// another reason (e.g. a new robot) is not measured as edit latency.
+	//
+	qint64 changedAt() const {
+		return changed_at_;
+	}
+
+	qint64 takeChangedAt() {
+		qint64 ret = changed_at_;
+		changed_at_ = 0;
+		return ret;
+	}
+
+	//
+	// Gives back a change taken by takeChangedAt() whose generation was canceled, so the
+	// path is still seen as changed since its last generation
+	//
+	void restoreChangedAt(qint64 changed) {
+		if (changed_at_ == 0 || changed < changed_at_) {
+			changed_at_ = changed;
+		}
+	}
+
 signals:
 	void afterPathChanged(const QString& groupName, const QString& pathName);
 	void beforePathChanged(std::shared_ptr<UndoAction> action);
@@ -148,6 +196,7 @@ signals:
 private:
 	void emitBeforePathChangedSignal(std::shared_ptr<UndoAction> action);
 	void emitAfterPathChangedSignal();
+	void updateSplines(int first, int last);
 
 	static bool readPoints(std::shared_ptr<RobotPath> path, const QJsonArray& obj, QString &msg);
 	static bool readConstraints(std::shared_ptr<RobotPath> path, const QJsonArray& obj, QString &msg);
@@ -163,4 +212,7 @@ private:
 	QVector<std::shared_ptr<PathConstraint>> constraints_;			// The set of constrains to apply to the path
 	PathParameters params_;											// The path velocity and acceleration parameters
 	QString units_;													// The units for this path
+	qint64 changed_at_;												// The time of the last change not yet queued for generation
+	std::shared_ptr<PathGroup> snapshot_group_;						// The copy of the group owned by a snapshot
+	mutable std::shared_ptr<const SplineSet> splines_;				// The splines through the waypoints, null until asked for
 };
@@ -16,86 +16,92 @@
 #include "SplinePair.h"
 #include <cmath>
 
-SplinePair::SplinePair(const Pose2d &p0, const Pose2d &p1)
+SplinePair::SplinePair(const Pose2d &p0, const Pose2d &p1) : SplinePair(p0, p1, 1.2 * p0.distance(p1))
 {
-	double dist = p0.distance(p1);
-	double scale = 1.2 * dist;
-	double x0 = p0.getTranslation().getX();
-	double x1 = p1.getTranslation().getX();
-	double dx0 = p0.getRotation().getCos() * scale;
-	double dx1 = p1.getRotation().getCos() * scale;
-	double ddx0 = 0.0;
-	double ddx1 = 0.0;
-	x_ = new QuinticHermiteSpline(x0, x1, dx0, dx1, ddx0, ddx1);
-
-	double y0 = p0.getTranslation().getY();
-	double y1 = p1.getTranslation().getY();
-	double dy0 = p0.getRotation().getSin() * scale;
-	double dy1 = p1.getRotation().getSin() * scale;
-	double ddy0 = 0.0;
-	double ddy1 = 0.0;
-	y_ = new QuinticHermiteSpline(y0, y1, dy0, dy1, ddy0, ddy1);
-
-	has_step_ = false;
-	step_ = 0.1;
 }
 
-SplinePair::SplinePair(const QuinticHermiteSpline& x, const QuinticHermiteSpline& y)
+SplinePair::SplinePair(const Pose2d& p0, const Pose2d& p1, double scale) :
+	x_(p0.getTranslation().getX(), p1.getTranslation().getX(), p0.getRotation().getCos() * scale, p1.getRotation().getCos() * scale, 0.0, 0.0),
+	y_(p0.getTranslation().getY(), p1.getTranslation().getY(), p0.getRotation().getSin() * scale, p1.getRotation().getSin() * scale, 0.0, 0.0)
 {
-	x_ = new QuinticHermiteSpline(x);
-	y_ = new QuinticHermiteSpline(y);
-
-	has_step_ = false;
-	step_ = 0.1;
 }
 
-SplinePair::~SplinePair()
+SplinePair::SplinePair(const QuinticHermiteSpline& x, const QuinticHermiteSpline& y) : x_(x), y_(y)
 {
-	delete x_;
-	delete y_;
 }
 
-Translation2d SplinePair::evalPosition(double t)
+Translation2d SplinePair::evalPosition(double t) const
 {
-	double xval = x_->eval(t);
-	double yval = y_->eval(t);
+	double xval = x_.eval(t);
+	double yval = y_.eval(t);
 
 	return Translation2d(xval, yval);
 }
 
-Rotation2d SplinePair::evalHeading(double t)
+Rotation2d SplinePair::evalHeading(double t) const
 {
-	double xval = x_->derivative(t);
-	double yval = y_->derivative(t);
+	double xval = x_.derivative(t);
+	double yval = y_.derivative(t);
 
 	return Rotation2d(xval, yval, true);
 }
 
-double SplinePair::getCurvature(double t)
+double SplinePair::getCurvature(double t) const
 {
 	return (dx(t) * ddy(t) - ddx(t) * dy(t)) / ((dx(t) * dx(t) + dy(t) * dy(t)) * std::sqrt((dx(t) * dx(t) + dy(t) * dy(t))));
 }
 
-double SplinePair::getDCurvature(double t)
+double SplinePair::getDCurvature(double t) const
 {
 	double dx2dy2 = (dx(t) * dx(t) + dy(t) * dy(t));
 	double num = (dx(t) * dddy(t) - dddx(t) * dy(t)) * dx2dy2 - 3 * (dx(t) * ddy(t) - ddx(t) * dy(t)) * (dx(t) * ddx(t) + dy(t) * ddy(t));
 	return num / (dx2dy2 * dx2dy2 * std::sqrt(dx2dy2));
 }
 
-double SplinePair::getDCurvature2(double t)
+//
+// The change in curvature per unit of distance along the spline, rather than per
+// unit of the spline parameter
+//
+double SplinePair::getDCurvatureDs(double t) const
+{
+	return getDCurvature(t) / std::sqrt(dx(t) * dx(t) + dy(t) * dy(t));
+}
+
+double SplinePair::getDCurvature2(double t) const
 {
 	double dx2dy2 = (dx(t) * dx(t) + dy(t) * dy(t));
 	double num = (dx(t) * dddy(t) - dddx(t) * dy(t)) * dx2dy2 - 3 * (dx(t) * ddy(t) - ddx(t) * dy(t)) * (dx(t) * ddx(t) + dy(t) * ddy(t));
 	return num * num / (dx2dy2 * dx2dy2 * dx2dy2 * dx2dy2 * dx2dy2);
 }
 
-Pose2d SplinePair::getStartPose()
+double SplinePair::arcLength() const
+{
+	double len = 0.0;
+	bool first = true;
+	Translation2d pos, prevpos;
+
+	for (float t = 0.0f; t <= 1.0f; t += 1.0f / kArcSteps)
+	{
+		pos = evalPosition(t);
+		if (first)
+			first = false;
+		else
+		{
+			len += pos.distance(prevpos);
+		}
+
+		prevpos = pos;
+	}
+
+	return len;
+}
+
+Pose2d SplinePair::getStartPose() const
 {
 	return Pose2d(evalPosition(0), evalHeading(0));
 }
 
-Pose2d SplinePair::getEndPose()
+Pose2d SplinePair::getEndPose() const
 {
 	return Pose2d(evalPosition(1), evalHeading(1));
 }
@@ -26,52 +26,73 @@ class SplinePair
 public:
 	SplinePair(const Pose2d &p0, const Pose2d &p1);
 	SplinePair(const QuinticHermiteSpline& x, const QuinticHermiteSpline& y);
-	virtual ~SplinePair();
 
 	QuinticHermiteSpline& getX() {
-		return *x_;
+		return x_;
 	}
 
 	QuinticHermiteSpline& getY() {
-		return *y_;
+		return y_;
 	}
 
-	double x0() { return x_->v0(); }
-	double x1() { return x_->v0(); }
-	double dx0() { return x_->dv0(); }
-	double dx1() { return x_->dv1(); }
-	double ddx0() { return x_->ddv0(); }
-	double ddx1() { return x_->ddv1(); }
+	const QuinticHermiteSpline& getX() const {
+		return x_;
+	}
+
+	const QuinticHermiteSpline& getY() const {
+		return y_;
+	}
+
+	double x0() const { return x_.v0(); }
+	double x1() const { return x_.v1(); }
+	double dx0() const { return x_.dv0(); }
+	double dx1() const { return x_.dv1(); }
+	double ddx0() const { return x_.ddv0(); }
+	double ddx1() const { return x_.ddv1(); }
 
-	double y0() { return y_->v0(); }
-	double y1() { return y_->v0(); }
-	double dy0() { return y_->dv0(); }
-	double dy1() { return y_->dv1(); }
-	double ddy0() { return y_->ddv0(); }
-	double ddy1() { return y_->ddv1(); }
+	double y0() const { return y_.v0(); }
+	double y1() const { return y_.v1(); }
+	double dy0() const { return y_.dv0(); }
+	double dy1() const { return y_.dv1(); }
+	double ddy0() const { return y_.ddv0(); }
+	double ddy1() const { return y_.ddv1(); }
 
 	void ddxy0(double x, double y) {
-		x_->ddv0(x);
-		y_->ddv0(y);
+		x_.ddv0(x);
+		y_.ddv0(y);
 	}
 
 	void ddxy1(double x, double y) {
-		x_->ddv1(x);
-		y_->ddv1(y);
+		x_.ddv1(x);
+		y_.ddv1(y);
 	}
 
-	Translation2d evalPosition(double t);
-	Rotation2d evalHeading(double t);
-	Pose2d evalPose(double t) { return Pose2d(evalPosition(t), evalHeading(t)); }
+	//
+	// Multiplies every length of the spline by a factor, e.g. to change its units
+	//
+	void scale(double s) {
+		x_.scale(s);
+		y_.scale(s);
+	}
+
+	Translation2d evalPosition(double t) const;
+	Rotation2d evalHeading(double t) const;
+	Pose2d evalPose(double t) const { return Pose2d(evalPosition(t), evalHeading(t)); }
 
-	double getCurvature(double t);
-	double getDCurvature(double t);
-	double getDCurvature2(double t);
+	double getCurvature(double t) const;
+	double getDCurvature(double t) const;
+	double getDCurvatureDs(double t) const;
+	double getDCurvature2(double t) const;
 
-	Pose2d getStartPose();
-	Pose2d getEndPose();
+	//
+	// The length of the spline, found by walking it in small steps of the spline parameter
+	//
+	double arcLength() const;
 
-	double sumDCurvature2() {
+	Pose2d getStartPose() const;
+	Pose2d getEndPose() const;
+
+	double sumDCurvature2() const {
 		double dt = 1.0 / kSamples;
 		double sum = 0;
 		for (double t = 0; t < 1.0; t += dt) {
@@ -80,56 +101,39 @@ public:
 		return sum;
 	}
 
-	bool hasStep() const {
-		return has_step_;
-	}
-
-	double step() const {
-		return step_;
-	}
-
-	void setStep(double v) {
-		step_ = v;
-		has_step_ = true;
-	}
-
-	void clearStep() {
-		has_step_ = false;
-		step_ = 0.1;
-	}
-
 private:
-	double dx(double t) {
-		return x_->derivative(t);
+	SplinePair(const Pose2d& p0, const Pose2d& p1, double scale);
+
+	double dx(double t) const {
+		return x_.derivative(t);
 	}
 
-	double ddx(double t) {
-		return x_->derivative2(t);
+	double ddx(double t) const {
+		return x_.derivative2(t);
 	}
 
-	double dddx(double t) {
-		return x_->derivative3(t);
+	double dddx(double t) const {
+		return x_.derivative3(t);
 	}
 
-	double dy(double t) {
-		return y_->derivative(t);
+	double dy(double t) const {
+		return y_.derivative(t);
 	}
 
-	double ddy(double t) {
-		return y_->derivative2(t);
+	double ddy(double t) const {
+		return y_.derivative2(t);
 	}
 
-	double dddy(double t) {
-		return y_->derivative3(t);
+	double dddy(double t) const {
+		return y_.derivative3(t);
 	}
 
 private:
 	static constexpr int kSamples = 100;
+	static constexpr int kArcSteps = 10000;
 
 private:
-	QuinticHermiteSpline* x_;
-	QuinticHermiteSpline* y_;
-	bool has_step_;
-	double step_;
+	QuinticHermiteSpline x_;					// The x coordinate, held by value so a set of pairs is contiguous
+	QuinticHermiteSpline y_;					// The y coordinate
 };
 
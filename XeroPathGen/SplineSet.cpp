@@ -0,0 +1,102 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "SplineSet.h"
+#include <algorithm>
+
+SplineSet::SplineSet(const QVector<Pose2dWithRotation>& points)
+{
+	double dist = 0.0;
+
+	render_scale_ = 0.0;
+
+	if (points.size() > 0) {
+		distances_.push_back(0.0);
+	}
+
+	for (int i = 0; i < points.size() - 1; i++) {
+		splines_.push_back(SplinePair(points[i], points[i + 1]));
+
+		double len = splines_.back().arcLength();
+		lengths_.push_back(len);
+
+		dist += len;
+		distances_.push_back(dist);
+	}
+}
+
+SplineSet::SplineSet(const SplineSet& prev, const QVector<Pose2dWithRotation>& points, int first, int last)
+{
+	int count = points.size() > 0 ? points.size() - 1 : 0;
+	int shift = count - prev.size();
+	bool steps = prev.render_steps_.size() == prev.size();
+
+	first = std::max(first, 0);
+	last = std::min(last, count - 1);
+
+	render_scale_ = prev.render_scale_;
+	splines_.reserve(count);
+	lengths_.reserve(count);
+	if (steps) {
+		render_steps_.reserve(count);
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (i >= first && i <= last) {
+			splines_.push_back(SplinePair(points[i], points[i + 1]));
+			lengths_.push_back(splines_.back().arcLength());
+			if (steps) {
+				render_steps_.push_back(0.0);
+			}
+		}
+		else {
+			int from = i < first ? i : i - shift;
+			splines_.push_back(prev.splines_[from]);
+			lengths_.push_back(prev.lengths_[from]);
+			if (steps) {
+				render_steps_.push_back(prev.render_steps_[from]);
+			}
+		}
+	}
+
+	//
+	// The distances up to the start of the first changed spline are unchanged
+	//
+	if (points.size() > 0) {
+		int keep = first + 1;
+		if (keep > prev.distances_.size()) {
+			keep = prev.distances_.size();
+		}
+
+		distances_ = prev.distances_.mid(0, keep);
+		if (distances_.size() == 0) {
+			distances_.push_back(0.0);
+		}
+
+		for (int i = distances_.size() - 1; i < count; i++) {
+			distances_.push_back(distances_.back() + lengths_[i]);
+		}
+	}
+}
+
+void SplineSet::setRenderStep(int index, double scale, double step) const
+{
+	if (scale != render_scale_) {
+		render_steps_ = QVector<double>(splines_.size(), 0.0);
+		render_scale_ = scale;
+	}
+
+	render_steps_[index] = step;
+}
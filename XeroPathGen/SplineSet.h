@@ -0,0 +1,97 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "SplinePair.h"
+#include "Pose2dWithRotation.h"
+#include <QtCore/QVector>
+
+//
+// The splines through the waypoints of one revision of a path, with the length of
+// each spline and the distance along the path to each waypoint.  A set is never
+// changed once made, so the path editor and the generator threads share the same
+// set rather than each building its own.  The pairs are held by value in one
+// contiguous array.
+//
+class SplineSet
+{
+public:
+	SplineSet(const QVector<Pose2dWithRotation>& points);
+
+	//
+	// The set for waypoints that differ from those of an earlier set only between the
+	// splines first and last of the new set.  Those splines are made again and the
+	// others, with their lengths and render steps, are copied from the earlier set.
+	// The distances are only added up again from the first changed spline onward.
+	//
+	SplineSet(const SplineSet& prev, const QVector<Pose2dWithRotation>& points, int first, int last);
+
+	int size() const {
+		return splines_.size();
+	}
+
+	bool isEmpty() const {
+		return splines_.size() == 0;
+	}
+
+	const SplinePair& operator[](int index) const {
+		return splines_[index];
+	}
+
+	const QVector<SplinePair>& splines() const {
+		return splines_;
+	}
+
+	//
+	// The arc length of one spline
+	//
+	double length(int index) const {
+		return lengths_[index];
+	}
+
+	//
+	// The length of the whole path
+	//
+	double length() const {
+		return distances_.size() > 0 ? distances_.back() : 0.0;
+	}
+
+	//
+	// The distance along the path to each waypoint, one per waypoint
+	//
+	const QVector<double>& distances() const {
+		return distances_;
+	}
+
+	//
+	// The step in the spline parameter the path editor draws a spline with, which
+	// depends on the scale of the view it was found for.  It is zero if no step has
+	// been found at this scale.  The render steps are the one part of a set that
+	// changes after it is made and are only used on the GUI thread.
+	//
+	double renderStep(int index, double scale) const {
+		return scale == render_scale_ && index < render_steps_.size() ? render_steps_[index] : 0.0;
+	}
+
+	void setRenderStep(int index, double scale, double step) const;
+
+private:
+	QVector<SplinePair> splines_;						// The splines between each pair of waypoints
+	QVector<double> lengths_;							// The arc length of each spline
+	QVector<double> distances_;							// The distance along the path to each waypoint
+	mutable QVector<double> render_steps_;				// The step each spline is drawn with, GUI thread only
+	mutable double render_scale_;						// The view scale the render steps were found at
+};
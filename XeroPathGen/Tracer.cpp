@@ -0,0 +1,240 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#include "Tracer.h"
+#include "RobotPath.h"
+#include "PathGroup.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <atomic>
+#include <vector>
+
+namespace
+{
+	struct TraceEvent
+	{
+		const char* category;
+		const char* name;
+		QString path;
+		qint64 start;
+		qint64 end;
+		int tid;
+	};
+
+	std::atomic<bool> enabled(false);
+	std::atomic<int> next_tid(1);
+
+	QMutex& eventLock()
+	{
+		static QMutex lock;
+		return lock;
+	}
+
+	std::vector<TraceEvent>& events()
+	{
+		static std::vector<TraceEvent> list;
+		return list;
+	}
+
+	QMap<int, QString>& threadNames()
+	{
+		static QMap<int, QString> names;
+		return names;
+	}
+
+	const QElapsedTimer& traceClock()
+	{
+		static QElapsedTimer timer = []() { QElapsedTimer t; t.start(); return t; }();
+		return timer;
+	}
+
+	//
+	// Threads are numbered in the order they first record a span, which reads
+	// better in the viewer than the native thread handles
+	//
+	int threadId()
+	{
+		thread_local int tid = 0;
+		if (tid == 0) {
+			tid = next_tid++;
+
+			QString name;
+			QThread* thread = QThread::currentThread();
+			if (QCoreApplication::instance() != nullptr && thread == QCoreApplication::instance()->thread()) {
+				name = "main";
+			}
+			else if (thread->objectName().length() > 0) {
+				name = thread->objectName();
+			}
+			else {
+				name = "worker " + QString::number(tid);
+			}
+
+			QMutexLocker lock(&eventLock());
+			threadNames().insert(tid, name);
+		}
+		return tid;
+	}
+}
+
+Tracer::Span::Span(const char* category, const char* name, const RobotPath* path)
+{
+	category_ = category;
+	name_ = name;
+	active_ = Tracer::isEnabled();
+	start_ = 0;
+
+	if (active_) {
+		path_ = Tracer::pathName(path);
+		start_ = Tracer::now();
+	}
+}
+
+Tracer::Span::~Span()
+{
+	finish();
+}
+
+void Tracer::Span::next(const char* name)
+{
+	finish();
+
+	name_ = name;
+	active_ = Tracer::isEnabled();
+	if (active_) {
+		start_ = Tracer::now();
+	}
+}
+
+void Tracer::Span::finish()
+{
+	if (active_) {
+		Tracer::addSpan(category_, name_, path_, start_, Tracer::now());
+		active_ = false;
+	}
+}
+
+void Tracer::setEnabled(bool enable)
+{
+	traceClock();
+	enabled = enable;
+}
+
+bool Tracer::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::clear()
+{
+	QMutexLocker lock(&eventLock());
+	events().clear();
+}
+
+int Tracer::spanCount()
+{
+	QMutexLocker lock(&eventLock());
+	return static_cast<int>(events().size());
+}
+
+qint64 Tracer::now()
+{
+	return traceClock().nsecsElapsed();
+}
+
+QString Tracer::pathName(const RobotPath* path)
+{
+	if (path == nullptr) {
+		return QString();
+	}
+
+	if (path->pathGroup() == nullptr) {
+		return path->name();
+	}
+
+	return path->fullname();
+}
+
+void Tracer::addSpan(const char* category, const char* name, const QString& path, qint64 start, qint64 end)
+{
+	if (!isEnabled()) {
+		return;
+	}
+
+	int tid = threadId();
+
+	QMutexLocker lock(&eventLock());
+	events().push_back({ category, name, path, start, end, tid });
+}
+
+bool Tracer::write(const QString& filename, QString& msg)
+{
+	QJsonArray list;
+
+	eventLock().lock();
+	for (int tid : threadNames().keys()) {
+		QJsonObject args;
+		args["name"] = threadNames().value(tid);
+
+		QJsonObject obj;
+		obj["name"] = "thread_name";
+		obj["ph"] = "M";
+		obj["pid"] = 1;
+		obj["tid"] = tid;
+		obj["args"] = args;
+		list.append(obj);
+	}
+
+	for (const TraceEvent& ev : events()) {
+		QJsonObject obj;
+		obj["name"] = ev.name;
+		obj["cat"] = ev.category;
+		obj["ph"] = "X";
+		obj["ts"] = ev.start / 1000.0;
+		obj["dur"] = (ev.end - ev.start) / 1000.0;
+		obj["pid"] = 1;
+		obj["tid"] = ev.tid;
+		if (ev.path.length() > 0) {
+			QJsonObject args;
+			args["path"] = ev.path;
+			obj["args"] = args;
+		}
+		list.append(obj);
+	}
+	eventLock().unlock();
+
+	QJsonObject top;
+	top["traceEvents"] = list;
+	top["displayTimeUnit"] = "ms";
+
+	QFile file(filename);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		msg = "cannot open file '" + filename + "' for writing";
+		return false;
+	}
+
+	file.write(QJsonDocument(top).toJson(QJsonDocument::Compact));
+	file.close();
+
+	return true;
+}
@@ -0,0 +1,90 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+class RobotPath;
+
+//
+// Records spans of time, tagged with the thread and the path being worked on, and
+// writes them in the Chrome trace event format so that they can be viewed in
+// chrome://tracing or Perfetto.  Recording is off until enabled, and a span costs
+// a single check when it is off.
+//
+class Tracer
+{
+public:
+	static constexpr const char* GeneratorCategory = "generator";
+	static constexpr const char* QueueCategory = "queue";
+	static constexpr const char* ExportCategory = "export";
+	static constexpr const char* LogCategory = "log";
+
+	//
+	// Records the time from construction to destruction.  Calling next() ends the
+	// current span and starts another, for a sequence of steps in one scope.
+	//
+	class Span
+	{
+	public:
+		Span(const char* category, const char* name, const RobotPath* path = nullptr);
+		~Span();
+
+		void next(const char* name);
+
+	private:
+		void finish();
+
+	private:
+		const char* category_;
+		const char* name_;
+		QString path_;
+		qint64 start_;
+		bool active_;
+	};
+
+public:
+	Tracer() = delete;
+	~Tracer() = delete;
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	//
+	// Discards every span recorded so far
+	//
+	static void clear();
+	static int spanCount();
+
+	//
+	// The time in nanoseconds on the clock used for spans
+	//
+	static qint64 now();
+
+	//
+	// Adds a span that was timed elsewhere, start and end are from now()
+	//
+	static void addSpan(const char* category, const char* name, const QString& path, qint64 start, qint64 end);
+
+	static QString pathName(const RobotPath* path);
+
+	//
+	// Writes the spans recorded as a Chrome trace JSON file
+	//
+	static bool write(const QString& filename, QString& msg);
+};
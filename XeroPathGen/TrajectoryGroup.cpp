@@ -14,9 +14,116 @@
 // limitations under the License.
 //
 #include "TrajectoryGroup.h"
+#include "TrajectoryNames.h"
+#include "TrajectoryUtils.h"
 
 TrajectoryGroup::TrajectoryGroup(GeneratorType type, std::shared_ptr<RobotPath> path)
 {
 	type_ = type;
 	path_ = path;
-}
\ No newline at end of file
+	preview_ = false;
+	interim_ = false;
+	robot_fields_ = RobotParams::AllFields;
+	timestep_ = 0.0;
+	gen_time_ = 0.0;
+	queue_time_ = 0.0;
+	has_res_error_ = false;
+	res_error_.position = 0.0;
+	res_error_.velocity = 0.0;
+	res_error_.duration = 0.0;
+
+	for (int i = 0; i < EventCount; i++) {
+		timestamps_[i] = 0;
+	}
+}
+
+//
+// Create a new trajectory group sampled at the given timestep from the timed trajectory
+// held by this group.  This is a single resampling pass and does not run the generator.
+// The swerve rotation is not part of the timed trajectory, so it is interpolated from the
+// main trajectory of this group.
+//
+std::shared_ptr<TrajectoryGroup> TrajectoryGroup::resample(double timestep, std::shared_ptr<RobotParams> robot)
+{
+	auto main = getTrajectory(TrajectoryName::Main);
+	if (main == nullptr || main->size() == 0 || timed_ == nullptr || timed_->size() == 0 || timestep <= 0.0) {
+		return nullptr;
+	}
+
+	auto group = std::make_shared<TrajectoryGroup>(type_, path_);
+	group->setSnapshot(snapshot_);
+	group->setPreview(preview_);
+	group->setRobotFields(robot_fields_);
+	group->setTimestep(timestep);
+	group->setTimedTrajectory(timed_);
+
+	QVector<Pose2dWithTrajectory> pts = TrajectoryUtils::convertToUniformTime(timed_->points(), timestep);
+	bool tank = (robot->getDriveType() == RobotParams::DriveType::TankDrive);
+
+	for (int i = 0; i < pts.size(); i++) {
+		Pose2dWithTrajectory& pt = pts[i];
+
+		if (tank) {
+			pt.pose().setSwrot(pt.rotation());
+			pt.setRotVel(0.0);
+		}
+		else {
+			int low = TrajectoryUtils::findIndex(main->points(), pt.time());
+			if (low == main->size() - 1) {
+				pt.pose().setSwrot((*main)[low].swrot());
+				pt.setRotVel((*main)[low].rotVel());
+			}
+			else {
+				const Pose2dWithTrajectory& p0 = (*main)[low];
+				const Pose2dWithTrajectory& p1 = (*main)[low + 1];
+				double percent = (pt.time() - p0.time()) / (p1.time() - p0.time());
+				pt.pose().setSwrot(p0.swrot().interpolate(p1.swrot(), percent));
+				pt.setRotVel((p1.rotVel() - p0.rotVel()) * percent + p0.rotVel());
+			}
+		}
+	}
+
+	auto traj = std::make_shared<PathTrajectory>(TrajectoryName::Main, pts);
+	group->addTrajectory(traj);
+
+	if (tank) {
+		double width = UnitConverter::convert(robot->getWheelBaseWidth(), robot->getLengthUnits(), snapshot()->units());
+		TrajectoryUtils::addTankDriveTrajectories(*group, width);
+	}
+
+	return group;
+}
+
+//
+// Create a new group holding the trajectories of this group in other length units.  A
+// change of units only scales the lengths, so the path is not generated again.  The
+// snapshot is converted too, so it stays the path the trajectories belong to.
+//
+std::shared_ptr<TrajectoryGroup> TrajectoryGroup::convert(const QString& units)
+{
+	auto from = snapshot();
+	double scale = UnitConverter::convert(1.0, from->units(), units);
+
+	auto group = std::make_shared<TrajectoryGroup>(*this);
+
+	auto snap = from->snapshot();
+	snap->convert(from->units(), units);
+	group->setSnapshot(snap);
+
+	for (auto it = group->trajectories_.begin(); it != group->trajectories_.end(); ++it) {
+		auto traj = std::make_shared<PathTrajectory>(*it.value());
+		traj->scale(scale);
+		it.value() = traj;
+	}
+
+	if (timed_ != nullptr) {
+		auto timed = std::make_shared<PathTrajectory>(*timed_);
+		timed->scale(scale);
+		group->setTimedTrajectory(timed);
+	}
+
+	group->res_error_.position *= scale;
+	group->res_error_.velocity *= scale;
+
+	return group;
+}
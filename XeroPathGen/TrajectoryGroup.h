@@ -18,11 +18,43 @@
 #include "GeneratorType.h"
 #include "RobotPath.h"
 #include "PathTrajectory.h"
+#include "RobotParams.h"
+#include "GeneratorStats.h"
+#include "AllocationCounter.h"
+#include "WarmStart.h"
 #include <QtCore/QMap>
 #include <memory>
 
 class TrajectoryGroup 
 {
+public:
+	//
+	// The points, from an edit to its result being handed back to the GUI, that
+	// are timestamped to measure edit-to-display latency
+	//
+	enum class Event : int
+	{
+		Changed,
+		Queued,
+		Started,
+		Generated,
+		Delivered,
+		Count
+	};
+
+	static constexpr int EventCount = static_cast<int>(Event::Count);
+
+	//
+	// How far the main trajectory is from one generated at a much finer resolution,
+	// in the units of the path
+	//
+	struct ResolutionError
+	{
+		double position;				// The largest distance between the two at the same distance along the path
+		double velocity;				// The largest difference in velocity at the same distance along the path
+		double duration;				// The difference in the time to drive the path
+	};
+
 public:
 	TrajectoryGroup(GeneratorType type, std::shared_ptr<RobotPath> path);
 
@@ -30,10 +62,58 @@ public:
 		return path_;
 	}
 
+	//
+	// The snapshot of the path that is generated, which the GUI does not change
+	// while it is being read.  This is the path itself if no snapshot was taken.
+	//
+	std::shared_ptr<RobotPath> snapshot() {
+		return (snapshot_ != nullptr) ? snapshot_ : path_;
+	}
+
+	void setSnapshot(std::shared_ptr<RobotPath> snapshot) {
+		snapshot_ = snapshot;
+	}
+
+	//
+	// A preview is a quick, low fidelity generation shown while a path is being dragged
+	//
+	bool isPreview() const {
+		return preview_;
+	}
+
+	void setPreview(bool preview) {
+		preview_ = preview;
+	}
+
+	//
+	// An interim group holds an intermediate main trajectory published while the path
+	// is still being generated.  It is replaced by the final group.
+	//
+	bool isInterim() const {
+		return interim_;
+	}
+
+	void setInterim(bool interim) {
+		interim_ = interim;
+	}
+
 	GeneratorType type() const {
 		return type_;
 	}
 
+	//
+	// The robot parameters read while generating the main trajectory.  A change to any
+	// other robot parameter leaves the trajectories unchanged.  The tank drive left and
+	// right trajectories also depend on the wheelbase width and the length units.
+	//
+	RobotParams::Fields robotFields() const {
+		return robot_fields_;
+	}
+
+	void setRobotFields(RobotParams::Fields fields) {
+		robot_fields_ = fields;
+	}
+
 	void addTrajectory(std::shared_ptr<PathTrajectory> traj) {
 		trajectories_.insert(traj->name(), traj);
 	}
@@ -56,14 +136,155 @@ public:
 		return err_msg_.length() > 0;
 	}
 
+	const QString& errorMessage() const {
+		return err_msg_;
+	}
+
+	//
+	// The wall clock time, in seconds, it took to generate this group
+	//
+	double generationTime() const {
+		return gen_time_;
+	}
+
+	void setGenerationTime(double t) {
+		gen_time_ = t;
+	}
+
+	//
+	// The time, on the Tracer clock, of an event, zero if it did not happen
+	//
+	qint64 timestamp(Event ev) const {
+		return timestamps_[static_cast<int>(ev)];
+	}
+
+	void setTimestamp(Event ev, qint64 t) {
+		timestamps_[static_cast<int>(ev)] = t;
+	}
+
+	//
+	// The time, in seconds, this group waited to be generated after it was requested
+	//
+	double queueTime() const {
+		return queue_time_;
+	}
+
+	void setQueueTime(double t) {
+		queue_time_ = t;
+	}
+
+	//
+	// The time spent in each stage of generating this group
+	//
+	const GeneratorStats& stats() const {
+		return stats_;
+	}
+
+	void setStats(const GeneratorStats& stats) {
+		stats_ = stats;
+	}
+
+	//
+	// The heap allocations made while generating this group, all zero unless
+	// allocation counting is enabled
+	//
+	const AllocationStats& allocations() const {
+		return allocs_;
+	}
+
+	void setAllocations(const AllocationStats& allocs) {
+		allocs_ = allocs;
+	}
+
+	//
+	// The swerve velocity percentages the generation settled on, which the next
+	// generation of the path starts its search from
+	//
+	const WarmStart& warmStart() const {
+		return warm_start_;
+	}
+
+	void setWarmStart(const WarmStart& ws) {
+		warm_start_ = ws;
+	}
+
+	//
+	// The estimated error of the main trajectory, only if it was asked for when the
+	// group was generated
+	//
+	bool hasResolutionError() const {
+		return has_res_error_;
+	}
+
+	const ResolutionError& resolutionError() const {
+		return res_error_;
+	}
+
+	void setResolutionError(const ResolutionError& err) {
+		res_error_ = err;
+		has_res_error_ = true;
+	}
+
+	//
+	// An estimate of the heap memory held by this group in bytes
+	//
+	qint64 memoryUsage() const {
+		qint64 ret = sizeof(TrajectoryGroup);
+		for (auto traj : trajectories_) {
+			ret += traj->memoryUsage();
+		}
+		if (timed_ != nullptr) {
+			ret += timed_->memoryUsage();
+		}
+		return ret;
+	}
+
 	QStringList trajectoryNames() const {
 		return trajectories_.keys();
 	}
 
+	double timestep() const {
+		return timestep_;
+	}
+
+	void setTimestep(double t) {
+		timestep_ = t;
+	}
+
+	//
+	// The timed trajectory is the non-uniform output of the time parameterization step
+	// that the uniform main trajectory was sampled from.  It is not one of the named
+	// trajectories and is never written to the output files.
+	//
+	std::shared_ptr<PathTrajectory> timedTrajectory() {
+		return timed_;
+	}
+
+	void setTimedTrajectory(std::shared_ptr<PathTrajectory> traj) {
+		timed_ = traj;
+	}
+
+	std::shared_ptr<TrajectoryGroup> resample(double timestep, std::shared_ptr<RobotParams> robot);
+	std::shared_ptr<TrajectoryGroup> convert(const QString& units);
+
 private:
 	GeneratorType type_;
 	std::shared_ptr<RobotPath> path_;
+	std::shared_ptr<RobotPath> snapshot_;
+	bool preview_;
+	bool interim_;
+	RobotParams::Fields robot_fields_;
 	QMap<QString, std::shared_ptr<PathTrajectory>> trajectories_;
+	std::shared_ptr<PathTrajectory> timed_;
+	double timestep_;
+	double gen_time_;
+	double queue_time_;
+	qint64 timestamps_[EventCount];
+	GeneratorStats stats_;
+	AllocationStats allocs_;
+	WarmStart warm_start_;
+	bool has_res_error_;
+	ResolutionError res_error_;
 	QString err_msg_;
 };
 
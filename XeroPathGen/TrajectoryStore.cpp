@@ -0,0 +1,111 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "TrajectoryStore.h"
+
+TrajectoryStore::TrajectoryStore(qint64 budget)
+{
+	budget_ = budget;
+	bytes_ = 0;
+	clock_ = 0;
+	evictions_ = 0;
+}
+
+void TrajectoryStore::setBudget(qint64 budget)
+{
+	budget_ = budget;
+	evict(nullptr);
+}
+
+void TrajectoryStore::insert(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group)
+{
+	remove(path);
+
+	Entry entry;
+	entry.group = group;
+	entry.bytes = group->memoryUsage();
+	entry.used = clock_++;
+
+	entries_.insert(path, entry);
+	bytes_ += entry.bytes;
+
+	evict(path);
+}
+
+std::shared_ptr<TrajectoryGroup> TrajectoryStore::get(std::shared_ptr<RobotPath> path)
+{
+	auto it = entries_.find(path);
+	if (it == entries_.end()) {
+		return nullptr;
+	}
+
+	it->used = clock_++;
+	return it->group;
+}
+
+bool TrajectoryStore::takeEvicted(std::shared_ptr<RobotPath> path, GeneratorType& type)
+{
+	if (!evicted_.contains(path)) {
+		return false;
+	}
+
+	type = evicted_.take(path);
+	return true;
+}
+
+void TrajectoryStore::remove(std::shared_ptr<RobotPath> path)
+{
+	auto it = entries_.find(path);
+	if (it != entries_.end()) {
+		bytes_ -= it->bytes;
+		entries_.erase(it);
+	}
+	evicted_.remove(path);
+}
+
+void TrajectoryStore::clear()
+{
+	entries_.clear();
+	evicted_.clear();
+	bytes_ = 0;
+}
+
+void TrajectoryStore::evict(std::shared_ptr<RobotPath> keep)
+{
+	if (budget_ <= 0) {
+		return;
+	}
+
+	//
+	// The group just stored is never dropped, even if it alone is over the budget
+	//
+	while (bytes_ > budget_) {
+		auto oldest = entries_.end();
+		for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+			if (it.key() != keep && (oldest == entries_.end() || it->used < oldest->used)) {
+				oldest = it;
+			}
+		}
+
+		if (oldest == entries_.end()) {
+			break;
+		}
+
+		evicted_.insert(oldest.key(), oldest->group->type());
+		bytes_ -= oldest->bytes;
+		entries_.erase(oldest);
+		evictions_++;
+	}
+}
@@ -0,0 +1,95 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "RobotPath.h"
+#include "GeneratorType.h"
+#include "TrajectoryGroup.h"
+#include <QtCore/QMap>
+#include <memory>
+
+//
+// Holds the most recent trajectory group generated for each path, within a memory
+// budget.  When the groups held exceed the budget the least recently used ones are
+// dropped, and the store remembers how to regenerate them when they are next asked
+// for.  The store does no locking of its own.
+//
+class TrajectoryStore
+{
+public:
+	static constexpr qint64 DefaultBudget = 256 * 1024 * 1024;
+
+public:
+	TrajectoryStore(qint64 budget = DefaultBudget);
+
+	//
+	// The most memory, in bytes, the groups held may use, zero for no limit
+	//
+	qint64 budget() const {
+		return budget_;
+	}
+
+	void setBudget(qint64 budget);
+
+	qint64 memoryUsage() const {
+		return bytes_;
+	}
+
+	int count() const {
+		return entries_.size();
+	}
+
+	//
+	// The number of groups dropped to stay within the budget since the store was created
+	//
+	int evictions() const {
+		return evictions_;
+	}
+
+	void insert(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group);
+
+	//
+	// Returns the group for a path and marks it as the most recently used
+	//
+	std::shared_ptr<TrajectoryGroup> get(std::shared_ptr<RobotPath> path);
+
+	//
+	// If the group for the path was dropped to stay within the budget, returns true and the
+	// generator it was made with, and forgets that it was dropped
+	//
+	bool takeEvicted(std::shared_ptr<RobotPath> path, GeneratorType& type);
+
+	void remove(std::shared_ptr<RobotPath> path);
+	void clear();
+
+private:
+	void evict(std::shared_ptr<RobotPath> keep);
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<TrajectoryGroup> group;
+		qint64 bytes;
+		quint64 used;
+	};
+
+	QMap<std::shared_ptr<RobotPath>, Entry> entries_;
+	QMap<std::shared_ptr<RobotPath>, GeneratorType> evicted_;
+	qint64 budget_;
+	qint64 bytes_;
+	quint64 clock_;
+	int evictions_;
+};
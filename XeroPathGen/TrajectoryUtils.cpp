@@ -14,27 +14,33 @@
 // limitations under the License.
 //
 #include "TrajectoryUtils.h"
+#include "TrajectoryNames.h"
 #include "RobotPath.h"
+#include <cassert>
+#include <cmath>
 
-QVector<Pose2dWithRotation> TrajectoryUtils::parameterize(const QVector<std::shared_ptr<SplinePair>>& splines,
-	double maxDx, double maxDy, double maxDTheta)
+QVector<Pose2dWithRotation> TrajectoryUtils::parameterize(const SplineSet& splines,
+	double maxDx, double maxDy, double maxDTheta, QVector<int>* ends)
 {
 	QVector<Pose2dWithRotation> results;
 
-	results.push_back(splines[0]->getStartPose());
-	for (int i = 0; i < splines.size(); i++)
+	results.push_back(evalPose(splines[0], 0.0));
+	for (int i = 0; i < splines.size(); i++) {
 		getSegmentArc(splines[i], results, 0.0, 1.0, maxDx, maxDy, maxDTheta);
+		if (ends != nullptr)
+			ends->push_back(results.size() - 1);
+	}
 
 	return results;
 }
 
-void TrajectoryUtils::getSegmentArc(std::shared_ptr<SplinePair> pair, QVector<Pose2dWithRotation>& results,
+void TrajectoryUtils::getSegmentArc(const SplinePair& pair, QVector<Pose2dWithRotation>& results,
 	double t0, double t1, double maxDx, double maxDy, double maxDTheta)
 {
-	const Translation2d& p0 = pair->evalPosition(t0);
-	const Translation2d& p1 = pair->evalPosition(t1);
-	const Rotation2d& r0 = pair->evalHeading(t0);
-	const Rotation2d& r1 = pair->evalHeading(t1);
+	const Translation2d& p0 = pair.evalPosition(t0);
+	const Translation2d& p1 = pair.evalPosition(t1);
+	const Rotation2d& r0 = pair.evalHeading(t0);
+	const Rotation2d& r1 = pair.evalHeading(t1);
 	Pose2d transformation = Pose2d(Translation2d(p0, p1).rotateBy(r0.inverse()), r1.rotateBy(r0.inverse()));
 	Twist2d twist = Pose2d::logfn(transformation);
 	if (twist.getY() > maxDy || twist.getX() > maxDx || twist.getTheta() > maxDTheta) {
@@ -42,10 +48,26 @@ void TrajectoryUtils::getSegmentArc(std::shared_ptr<SplinePair> pair, QVector<Po
 		getSegmentArc(pair, results, (t0 + t1) / 2, t1, maxDx, maxDy, maxDTheta);
 	}
 	else {
-		results.push_back(pair->evalPose(t1));
+		results.push_back(evalPose(pair, t1));
 	}
 }
 
+//
+// A point on a spline with its exact curvature, which every later stage interpolates
+// rather than estimating it again from neighboring points.  A spline between two
+// waypoints in the same place has no direction, so its curvature is zero.
+//
+Pose2dWithRotation TrajectoryUtils::evalPose(const SplinePair& pair, double t)
+{
+	Pose2dWithRotation pose(pair.evalPose(t));
+	double curv = pair.getCurvature(t);
+	double dcurv = pair.getDCurvatureDs(t);
+
+	pose.setCurvature(std::isfinite(curv) ? curv : 0.0);
+	pose.setDCurvature(std::isfinite(dcurv) ? dcurv : 0.0);
+	return pose;
+}
+
 double TrajectoryUtils::rotationalToLinear(std::shared_ptr<RobotParams> robot, double rv)
 {
 	double diameter = std::sqrt(robot->getWheelBaseWidth() * robot->getWheelBaseWidth() + robot->getWheelBaseLength() * robot->getWheelBaseLength());
@@ -60,71 +82,190 @@ double TrajectoryUtils::linearToRotational(std::shared_ptr<RobotParams> robot, d
 	return gr * 360.0 / circum;
 }
 
-void TrajectoryUtils::computeCurvature(std::shared_ptr<PathTrajectory> traj)
+int TrajectoryUtils::findIndex(const QVector<Pose2dWithTrajectory>& traj, double time)
 {
-	double curv;
+	if (time < traj[0].time())
+		return 0;
 
-	auto pts = *traj;
-	for (int i = 0; i < traj->size(); i++) {
-		if (i == 0 || i == traj->size() - 1)
+	if (time > traj[traj.size() - 1].time())
+		return traj.size() - 1;
+
+	int low = 0;
+	int high = traj.size() - 1;
+
+	while (high - low > 1)
+	{
+		int center = (high + low) / 2;
+		if (time > traj[center].time())
 		{
-			curv = 0.0;
+			low = center;
 		}
 		else
 		{
-			curv = Pose2dWithRotation::curvature(pts[i - 1].pose(), pts[i].pose(), pts[i + 1].pose());
-			pts[i].pose().setCurvature(curv);
+			high = center;
 		}
 	}
-}
 
+	return low;
+}
 
-void TrajectoryUtils::computeCurvature(QVector<Pose2dWithRotation>& pts)
+QVector<Pose2dWithTrajectory> TrajectoryUtils::convertToUniformTime(const QVector<Pose2dWithTrajectory>& traj, double step)
 {
-	double curv;
+	QVector<Pose2dWithTrajectory> result;
+
+	for (double time = 0.0; time < traj[traj.size() - 1].time(); time += step)
+	{
+		Pose2dWithTrajectory newpt;
 
-	for (int i = 0; i < pts.size(); i++) {
-		if (i == 0 || i == pts.size() - 1)
+		int low = findIndex(traj, time);
+		if (low == traj.size() - 1)
 		{
-			curv = 0.0;
+			newpt = traj[traj.size() - 1];
 		}
 		else
 		{
-			curv = Pose2dWithRotation::curvature(pts[i - 1], pts[i], pts[i + 1]);
-			pts[i].setCurvature(curv);
+			double percent = (time - traj[low].time()) / (traj[low + 1].time() - traj[low].time());
+			newpt = traj[low].interpolate(traj[low + 1], percent);
 		}
+
+		result.push_back(newpt);
 	}
+
+	return result;
 }
 
-QVector<double> TrajectoryUtils::getDistancesForSplines(const QVector<std::shared_ptr<SplinePair>>& splines)
+//
+// The curvature of a path offset to the left of another by a distance, negative for
+// the right.  A wheel at the center of the turn pivots in place and has no curvature.
+//
+void TrajectoryUtils::offsetCurvature(const Pose2dWithRotation& center, double offset, Pose2dWithRotation& pose)
 {
-	QVector<double> dists;
+	double scale = 1.0 - offset * center.curvature();
+
+	if (std::fabs(scale) < 1e-9) {
+		pose.setCurvature(0.0);
+		pose.setDCurvature(0.0);
+	}
+	else {
+		pose.setCurvature(center.curvature() / scale);
+		pose.setDCurvature(center.dcurvature() / (scale * scale * scale));
+	}
+}
+
+void TrajectoryUtils::addTankDriveTrajectories(TrajectoryGroup& group, double width)
+{
+	auto traj = group.getTrajectory(TrajectoryName::Main);
+	if (traj == nullptr) {
+		return;
+	}
+
+	QVector<Pose2dWithTrajectory> leftpts;
+	QVector<Pose2dWithTrajectory> rightpts;
+
+	double lvel = 0, lacc = 0, lpos = 0;
+	double rvel = 0, racc = 0, rpos = 0;
+	double plx = 0, ply = 0, prx = 0, pry = 0;
+	double plvel = 0, prvel = 0;
 
-	if (splines.length() > 0) {
-		int steps = 10000;
-		double dist = 0;
+	for (int i = 0; i < traj->size(); i++)
+	{
+		const Pose2dWithTrajectory& pt = (*traj)[i];
+		double time = pt.time();
+		double px = pt.x();
+		double py = pt.y();
 
-		dists.push_back(0.0);
-		for (int i = 0; i < splines.size(); i++)
+		double lx = px - width * pt.rotation().getSin() / 2.0;
+		double ly = py + width * pt.rotation().getCos() / 2.0;
+		double rx = px + width * pt.rotation().getSin() / 2.0;
+		double ry = py - width * pt.rotation().getCos() / 2.0;
+
+		if (i == 0)
 		{
-			auto pair = splines[i];
-			bool first = true;
-			Translation2d pos, prevpos;
-			for (float t = 0.0f; t <= 1.0f; t += 1.0f / steps)
-			{
-				pos = pair->evalPosition(t);
-				if (first)
-					first = false;
-				else
-				{
-					dist += pos.distance(prevpos);
-				}
-
-				prevpos = pos;
-			}
-
-			dists.push_back(dist);
+			lvel = 0.0;
+			lacc = 0.0;
+			lpos = 0.0;
+
+			rvel = 0.0;
+			racc = 0.0;
+			rpos = 0.0;
 		}
+		else
+		{
+			double dt = time - (*traj)[i - 1].time();
+			double ldist = std::sqrt((lx - plx) * (lx - plx) + (ly - ply) * (ly - ply));
+			double rdist = std::sqrt((rx - prx) * (rx - prx) + (ry - pry) * (ry - pry));
+
+			lvel = ldist / dt;
+			rvel = rdist / dt;
+
+			lacc = (lvel - plvel) / dt;
+			racc = (rvel - prvel) / dt;
+
+			lpos += ldist;
+			rpos += rdist;
+		}
+
+		Translation2d lpt(lx, ly);
+		Pose2dWithRotation l2d(lpt, pt.rotation());
+		offsetCurvature(pt.pose(), width / 2.0, l2d);
+		Pose2dWithTrajectory ltraj(l2d, time, lpos, lvel, lacc);
+		leftpts.push_back(ltraj);
+
+		Translation2d rpt(rx, ry);
+		Pose2dWithRotation r2d(rpt, pt.rotation());
+		offsetCurvature(pt.pose(), -width / 2.0, r2d);
+		Pose2dWithTrajectory rtraj(r2d, time, rpos, rvel, racc);
+		rightpts.push_back(rtraj);
+
+		plx = lx;
+		ply = ly;
+		prx = rx;
+		pry = ry;
+		plvel = lvel;
+		prvel = rvel;
 	}
-	return dists;
+
+	assert(leftpts.size() == rightpts.size());
+
+	std::shared_ptr<PathTrajectory> left = std::make_shared<PathTrajectory>(TrajectoryName::Left, leftpts);
+	std::shared_ptr<PathTrajectory> right = std::make_shared<PathTrajectory>(TrajectoryName::Right, rightpts);
+
+	group.addTrajectory(left);
+	group.addTrajectory(right);
+}
+
+TrajectoryGroup::ResolutionError TrajectoryUtils::compare(const PathTrajectory& traj, const PathTrajectory& ref)
+{
+	TrajectoryGroup::ResolutionError err;
+	err.position = 0.0;
+	err.velocity = 0.0;
+	err.duration = std::fabs(traj.getEndTime() - ref.getEndTime());
+
+	if (ref.size() == 0)
+		return err;
+
+	int index = 0;
+	for (const Pose2dWithTrajectory& pt : traj) {
+		//
+		// Both trajectories are ordered by distance, so the reference is walked once
+		//
+		while (index < ref.size() - 1 && ref[index + 1].position() < pt.position())
+			index++;
+
+		Translation2d pos = ref[index].translation();
+		double vel = ref[index].velocity();
+
+		if (index < ref.size() - 1 && pt.position() > ref[index].position()) {
+			const Pose2dWithTrajectory& next = ref[index + 1];
+			double len = next.position() - ref[index].position();
+			double percent = (len > 1e-9) ? (pt.position() - ref[index].position()) / len : 0.0;
+			pos = pos.interpolate(next.translation(), percent);
+			vel = vel + (next.velocity() - vel) * percent;
+		}
+
+		err.position = std::max(err.position, pt.translation().distance(pos));
+		err.velocity = std::max(err.velocity, std::fabs(pt.velocity() - vel));
+	}
+
+	return err;
 }
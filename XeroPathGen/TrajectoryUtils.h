@@ -15,10 +15,11 @@
 //
 #pragma once
 
-#include "SplinePair.h"
+#include "SplineSet.h"
 #include "Pose2dWithRotation.h"
 #include "RobotParams.h"
 #include "PathTrajectory.h"
+#include "TrajectoryGroup.h"
 #include <QtCore/QVector>
 
 class TrajectoryUtils
@@ -27,20 +28,30 @@ public:
 	TrajectoryUtils() = delete;
 	~TrajectoryUtils() = delete;
 
-	static QVector<Pose2dWithRotation> parameterize(const QVector<std::shared_ptr<SplinePair>>& splines,
-		double maxDx, double maxDy, double maxDTheta);
+	//
+	// If ends is given, the index of the last point of each spline is added to it
+	//
+	static QVector<Pose2dWithRotation> parameterize(const SplineSet& splines,
+		double maxDx, double maxDy, double maxDTheta, QVector<int>* ends = nullptr);
 
 	static double linearToRotational(std::shared_ptr<RobotParams> robot, double v);
 	static double rotationalToLinear(std::shared_ptr<RobotParams> robot, double v);
 
-	static void computeCurvature(std::shared_ptr<PathTrajectory> traj);
+	static QVector<Pose2dWithTrajectory> convertToUniformTime(const QVector<Pose2dWithTrajectory>& traj, double step);
+	static int findIndex(const QVector<Pose2dWithTrajectory>& traj, double time);
 
-	static void computeCurvature(QVector<Pose2dWithRotation>& points);
+	static void addTankDriveTrajectories(TrajectoryGroup& group, double width);
 
-	static QVector<double> getDistancesForSplines(const QVector<std::shared_ptr<SplinePair>>& splines);
+	//
+	// The largest difference in position and velocity between a trajectory and a
+	// reference trajectory of the same path, compared at the same distance along it
+	//
+	static TrajectoryGroup::ResolutionError compare(const PathTrajectory& traj, const PathTrajectory& ref);
 
 private:
-	static void getSegmentArc(std::shared_ptr<SplinePair> pair, QVector<Pose2dWithRotation>& results,
+	static Pose2dWithRotation evalPose(const SplinePair& pair, double t);
+	static void offsetCurvature(const Pose2dWithRotation& center, double offset, Pose2dWithRotation& pose);
+	static void getSegmentArc(const SplinePair& pair, QVector<Pose2dWithRotation>& results,
 		double t0, double t1, double maxDx, double maxDy, double maxDTheta);
 };
 
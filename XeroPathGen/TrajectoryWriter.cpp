@@ -0,0 +1,67 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "TrajectoryWriter.h"
+#include "PathGroup.h"
+#include "CSVWriter.h"
+#include "Tracer.h"
+#include <fstream>
+
+bool TrajectoryWriter::write(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QDir& dir, QString& msg)
+{
+	Tracer::Span span(Tracer::ExportCategory, "csv", path.get());
+
+	if (!writeGroup(path, group, "", dir, msg))
+		return false;
+
+	for (const PathVariant& variant : path->pathGroup()->variants()) {
+		if (!writeGroup(path, variant.transform(group), variant.suffix(), dir, msg))
+			return false;
+	}
+
+	return true;
+}
+
+bool TrajectoryWriter::writeGroup(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QString& suffix, const QDir& dir, QString& msg)
+{
+	QVector<QString> headers =
+	{
+		RobotPath::TimeTag,
+		RobotPath::XTag,
+		RobotPath::YTag,
+		RobotPath::PositionTag,
+		RobotPath::VelocityTag,
+		RobotPath::AccelerationTag,
+		RobotPath::HeadingTag,
+		RobotPath::CurvatureTag,
+		RobotPath::RotationTag,
+	};
+
+	for (const QString& name : group->trajectoryNames())
+	{
+		auto traj = group->getTrajectory(name);
+		QString filename = dir.absoluteFilePath(path->pathGroup()->name() + "-" + path->name() + suffix + "-" + name + ".csv");
+
+		std::ofstream outstrm(filename.toStdString());
+		if (!outstrm.is_open()) {
+			msg = "cannot open file '" + filename + "' for writing";
+			return false;
+		}
+
+		CSVWriter::write<QVector<Pose2dWithTrajectory>::const_iterator>(outstrm, headers, traj->begin(), traj->end());
+	}
+
+	return true;
+}
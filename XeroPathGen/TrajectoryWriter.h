@@ -0,0 +1,39 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "RobotPath.h"
+#include "TrajectoryGroup.h"
+#include <QtCore/QDir>
+#include <QtCore/QString>
+#include <memory>
+
+class TrajectoryWriter
+{
+public:
+	TrajectoryWriter() = delete;
+	~TrajectoryWriter() = delete;
+
+	//
+	// Write each trajectory in the group to a CSV file in the directory given.  The
+	// files are named <group>-<path>-<trajectory>.csv.  Each variant of the path group
+	// is transformed from the group and written to <group>-<path>_<variant>-<trajectory>.csv.
+	//
+	static bool write(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QDir& dir, QString& msg);
+
+private:
+	static bool writeGroup(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QString& suffix, const QDir& dir, QString& msg);
+};
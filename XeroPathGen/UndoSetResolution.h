@@ -0,0 +1,36 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+#include "UndoAction.h"
+#include "ResolutionPreset.h"
+
+class PathsDataModel;
+
+class UndoSetResolution : public UndoAction
+{
+public:
+	UndoSetResolution(ResolutionPreset preset, bool adaptive, PathsDataModel &model) : model_(model) {
+		preset_ = preset;
+		adaptive_ = adaptive;
+	}
+
+	void apply() override;
+
+private:
+	PathsDataModel& model_;
+	ResolutionPreset preset_;
+	bool adaptive_;
+};
@@ -0,0 +1,102 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "Pose2dWithRotation.h"
+#include <QtCore/QVector>
+
+//
+// The velocity percentages a swerve generation settled on.  They are kept with the
+// trajectories so the next generation of the path can start its search from them
+// rather than from full velocity.  Segments are matched by the waypoints at their
+// ends, so the segments an edit did not touch find their own percentages again.
+//
+class WarmStart
+{
+public:
+	struct Segment
+	{
+		Pose2dWithRotation from;
+		Pose2dWithRotation to;
+		double percent;
+	};
+
+public:
+	WarmStart() {
+		single_ = -1.0;
+	}
+
+	bool isEmpty() const {
+		return single_ < 0.0 && segments_.size() == 0;
+	}
+
+	//
+	// The percentage of a single rotation generation, negative if there is none
+	//
+	double singlePercent() const {
+		return single_;
+	}
+
+	void setSinglePercent(double percent) {
+		single_ = percent;
+	}
+
+	void addSegment(const Pose2dWithRotation& from, const Pose2dWithRotation& to, double percent) {
+		Segment seg;
+		seg.from = from;
+		seg.to = to;
+		seg.percent = percent;
+		segments_.push_back(seg);
+	}
+
+	//
+	// The percentage of the segment between two waypoints, negative if there is none.
+	// A segment that is not found takes the percentage at the same index if the number
+	// of segments is unchanged, as happens to the segments next to a moved waypoint.
+	//
+	double segmentPercent(int index, int count, const Pose2dWithRotation& from, const Pose2dWithRotation& to) const {
+		for (const Segment& seg : segments_) {
+			if (same(seg.from, from) && same(seg.to, to)) {
+				return seg.percent;
+			}
+		}
+
+		if (count == segments_.size() && index < segments_.size()) {
+			return segments_[index].percent;
+		}
+
+		return -1.0;
+	}
+
+	const QVector<Segment>& segments() const {
+		return segments_;
+	}
+
+private:
+	static bool same(const Pose2dWithRotation& a, const Pose2dWithRotation& b) {
+		return a.getTranslation().getX() == b.getTranslation().getX() &&
+			a.getTranslation().getY() == b.getTranslation().getY() &&
+			a.getRotation().getCos() == b.getRotation().getCos() &&
+			a.getRotation().getSin() == b.getRotation().getSin() &&
+			a.getSwrot().getCos() == b.getSwrot().getCos() &&
+			a.getSwrot().getSin() == b.getSwrot().getSin() &&
+			a.getSwrotVelocity() == b.getSwrotVelocity();
+	}
+
+private:
+	QVector<Segment> segments_;
+	double single_;
+};
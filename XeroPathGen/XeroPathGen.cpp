@@ -14,7 +14,9 @@
 // limitations under the License.
 //
 #include "XeroPathGen.h"
-#include "CSVWriter.h"
+#include "TrajectoryWriter.h"
+#include "Tracer.h"
+#include "GenerationCapture.h"
 #include "PropertyEditor.h"
 #include "EditableProperty.h"
 #include "DriveBaseData.h"
@@ -35,16 +37,23 @@
 #include "UndoRenameGroup.h"
 #include "UndoRenamePath.h"
 #include <QtCore/QCoreApplication>
+#include <QtCore/QSignalBlocker>
 #include <QtWidgets/QDockWidget>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QMenuBar>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QInputDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtWidgets/QProgressDialog>
 #include <QtWidgets/QStatusBar>
 #include <QtWidgets/QLabel>
 #include <QtGui/QCloseEvent>
 #include <QtGui/QActionGroup>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QScreen>
 #include <fstream>
+#include <cmath>
+#include <algorithm>
 
 XeroPathGen* XeroPathGen::theOne = nullptr;
 
@@ -60,12 +69,14 @@ XeroPathGen::XeroPathGen(const QStringList &arglist, RobotManager& robots, GameF
 	QIcon icon(image);
 	setWindowIcon(icon);
 
+	robot_changes_ = RobotParams::AllFields;
 	path_edit_win_ = nullptr;
 	path_win_ = nullptr;
 	waypoint_win_ = nullptr;
 	plot_win_ = nullptr;
 	constraint_win_ = nullptr;
 	logwin_ = nullptr;
+	metrics_win_ = nullptr;
 
 	dock_path_params_win_ = nullptr;
 	dock_path_win_ = nullptr;
@@ -73,8 +84,29 @@ XeroPathGen::XeroPathGen(const QStringList &arglist, RobotManager& robots, GameF
 	dock_plot_win_ = nullptr;
 	dock_constraint_win_ = nullptr;
 	dock_logwin_ = nullptr;
+	dock_metrics_win_ = nullptr;
 
 	custom_plot_ = true;
+	latency_overlay_ = settings_.value(LatencyOverlaySetting, false).toBool();
+
+	generator_.setEstimateError(settings_.value(EstimateErrorSetting, false).toBool());
+
+	if (settings_.contains(TrajectoryBudgetSetting)) {
+		generator_.setTrajectoryBudget(settings_.value(TrajectoryBudgetSetting).toLongLong() * 1024 * 1024);
+	}
+
+	//
+	// While a waypoint is dragged, previews of the path are generated at most once per
+	// display refresh however often the mouse moves
+	//
+	double refresh = 60.0;
+	if (QGuiApplication::primaryScreen() != nullptr && QGuiApplication::primaryScreen()->refreshRate() > 0.0) {
+		refresh = QGuiApplication::primaryScreen()->refreshRate();
+	}
+	preview_timer_ = new QTimer(this);
+	preview_timer_->setSingleShot(true);
+	preview_timer_->setInterval(std::max(1, static_cast<int>(1000.0 / refresh)));
+	(void)connect(preview_timer_, &QTimer::timeout, this, &XeroPathGen::generatePreview);
 
 	if (settings_.contains("plottype")) {
 		custom_plot_ = settings_.value("plottype").toBool();
@@ -116,9 +148,12 @@ XeroPathGen::XeroPathGen(const QStringList &arglist, RobotManager& robots, GameF
 
 	setWindowTitle("Error Code Xero Path Generator (file):");
 
+	generator_.setPublishProgress(true);
+	connect(&generator_, &GenerationMgr::generationProgress, this, &XeroPathGen::trajectoryGenerationProgress);
 	connect(&generator_, &GenerationMgr::generationComplete, this, &XeroPathGen::trajectoryGenerationComplete);
 	connect(&paths_data_model_, &PathsDataModel::unitsChanged, this, &XeroPathGen::setUnits);
 	connect(&paths_data_model_, &PathsDataModel::trajectoryGeneratorChanged, this, &XeroPathGen::trajectoryGeneratorChanged);
+	connect(&paths_data_model_, &PathsDataModel::resolutionChanged, this, &XeroPathGen::trajectoryGeneratorChanged);
 
 	processArguments();
 }
@@ -178,6 +213,19 @@ void XeroPathGen::setUnits(const QString& units)
 	}
 
 	dock_path_win_->setWindowTitle("Paths: units '" + units + "'");
+
+	//
+	// The trajectories were converted rather than generated again, so the converted
+	// trajectories of the selected path replace the ones shown.  Times are unchanged,
+	// so the slider keeps its place.
+	//
+	auto path = path_win_->selectedPath();
+	if (path != nullptr) {
+		auto group = generator_.getTrajectoryGroup(path);
+		if (group != nullptr) {
+			setTrajectoryGroup(group, true);
+		}
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -274,6 +322,15 @@ bool XeroPathGen::createWindows()
 	dock_logwin_->hide();
 	logger_.setLogWindow(logwin_);
 
+	metrics_win_ = new GenerationMetricsWindow(generator_, nullptr);
+	dock_metrics_win_ = new QDockWidget(tr("Generation Metrics"));
+	dock_metrics_win_->setObjectName("metricswin");
+	dock_metrics_win_->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::TopDockWidgetArea | Qt::BottomDockWidgetArea);
+	dock_metrics_win_->setWidget(metrics_win_);
+	addDockWidget(Qt::BottomDockWidgetArea, dock_metrics_win_);
+	tabifyDockWidget(dock_logwin_, dock_metrics_win_);
+	dock_metrics_win_->hide();
+
 	return true;
 }
 
@@ -303,6 +360,8 @@ bool XeroPathGen::createMenus()
 	(void)connect(action, &QAction::triggered, this, &XeroPathGen::fileGenerateAs);
 	action = file_menu_->addAction(tr("Generate Paths"));
 	(void)connect(action, &QAction::triggered, this, &XeroPathGen::fileGenerate);
+	action = file_menu_->addAction(tr("Export Timesteps ..."));
+	(void)connect(action, &QAction::triggered, this, &XeroPathGen::fileExportTimesteps);
 	file_menu_->addSeparator();
 	recent_menu_ = file_menu_->addMenu("Recent Files");
 	recent_project_menu_ = file_menu_->addMenu("Recent Projects");
@@ -326,6 +385,7 @@ bool XeroPathGen::createMenus()
 	window_menu_->addAction(dock_constraint_win_->toggleViewAction());
 	window_menu_->addAction(dock_plot_win_->toggleViewAction());
 	window_menu_->addAction(dock_logwin_->toggleViewAction());
+	window_menu_->addAction(dock_metrics_win_->toggleViewAction());
 	window_menu_->addSeparator();
 
 	QActionGroup* gr = new QActionGroup(this);
@@ -341,6 +401,16 @@ bool XeroPathGen::createMenus()
 		action->setChecked(true);
 	(void)connect(action, &QAction::triggered, this, &XeroPathGen::customPlotPlots);
 	gr->addAction(action);
+	window_menu_->addSeparator();
+	action = window_menu_->addAction(tr("Edit Latency Overlay"));
+	action->setCheckable(true);
+	action->setChecked(latency_overlay_);
+	(void)connect(action, &QAction::toggled, this, &XeroPathGen::showLatencyOverlay);
+	showLatencyOverlay(latency_overlay_);
+	action = window_menu_->addAction(tr("Estimate Resolution Error"));
+	action->setCheckable(true);
+	action->setChecked(generator_.estimateError());
+	(void)connect(action, &QAction::toggled, this, &XeroPathGen::estimateResolutionError);
 
 
 	help_menu_ = new QMenu(tr("&Help"));
@@ -349,6 +419,16 @@ bool XeroPathGen::createMenus()
 	(void)connect(action, &QAction::triggered, this, &XeroPathGen::showAbout);
 	action = help_menu_->addAction(tr("Changes"));
 	(void)connect(action, &QAction::triggered, this, &XeroPathGen::showChanges);
+	help_menu_->addSeparator();
+	action = help_menu_->addAction(tr("Record Trace"));
+	action->setCheckable(true);
+	action->setChecked(Tracer::isEnabled());
+	(void)connect(action, &QAction::toggled, this, &XeroPathGen::recordTrace);
+	action = help_menu_->addAction(tr("Save Trace ..."));
+	(void)connect(action, &QAction::triggered, this, &XeroPathGen::saveTrace);
+	action = help_menu_->addAction(tr("Capture Generation Inputs ..."));
+	action->setCheckable(true);
+	(void)connect(action, &QAction::toggled, this, [this, action](bool checked) { captureInputs(action, checked); });
 
 	return true;
 }
@@ -728,41 +808,81 @@ void XeroPathGen::fileGenerate()
 			}
 		}
 
-		updateAllPaths(true);
+		auto batch = updateAllPaths();
+		if (!waitForBatch(batch, "Generating paths ...")) {
+			return;
+		}
 
 		//
 		// Now all paths have been processed
 		//
-		for (auto path : paths_data_model_.getAllPaths()) {
-			auto trajgrp = generator_.getTrajectoryGroup(path);
-			generateOnePath(path, trajgrp);
+		for (auto path : batch->paths()) {
+			generateOnePath(path, batch->group(path), dirobj);
+		}
+
+		//
+		// Any additional timesteps are resampled from the trajectories just generated
+		// and each is written to its own directory under the output directory
+		//
+		for (double step : paths_data_model_.exportTimesteps()) {
+			if (std::fabs(step - generator_.timestep()) < 1e-9)
+				continue;
+
+			QDir stepdir = QDir(dirobj.absoluteFilePath(QString::number(step * 1000.0) + "ms"));
+			if (!stepdir.exists() && !stepdir.mkpath(stepdir.absolutePath())) {
+				QMessageBox::critical(this, "Error!", "Cannot create the destination directory '" + stepdir.absolutePath() + "' - path generation failed");
+				return;
+			}
+
+			for (auto path : batch->paths()) {
+				auto trajgrp = batch->group(path);
+				if (trajgrp != nullptr) {
+					auto resampled = trajgrp->resample(step, current_robot_);
+					if (resampled != nullptr) {
+						generateOnePath(path, resampled, stepdir);
+					}
+				}
+			}
 		}
 	}
 }
 
-void XeroPathGen::generateOnePath(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group)
+void XeroPathGen::fileExportTimesteps()
 {
-	QVector<QString> headers =
-	{
-		RobotPath::TimeTag,
-		RobotPath::XTag,
-		RobotPath::YTag,
-		RobotPath::PositionTag,
-		RobotPath::VelocityTag,
-		RobotPath::AccelerationTag,
-		RobotPath::HeadingTag,
-		RobotPath::CurvatureTag,
-		RobotPath::RotationTag,
-	};
-
-	for (const QString& name : group->trajectoryNames())
-	{
-		auto traj = group->getTrajectory(name);
-		QDir dirobj = QDir(paths_data_model_.outputDir());
-		QString filename = dirobj.absoluteFilePath(path->pathGroup()->name() + "-" + path->name() + "-" + name + ".csv");
+	QString current;
+	for (double step : paths_data_model_.exportTimesteps()) {
+		if (current.length() > 0)
+			current += ", ";
+		current += QString::number(step * 1000.0);
+	}
+
+	bool ok;
+	QString text = QInputDialog::getText(this, "Export Timesteps", "Additional timesteps in milliseconds (comma separated)", QLineEdit::Normal, current, &ok);
+	if (!ok)
+		return;
+
+	QVector<double> steps;
+	for (const QString& one : text.split(",", Qt::SkipEmptyParts)) {
+		double ms = one.trimmed().toDouble(&ok);
+		if (!ok || ms <= 0.0) {
+			QMessageBox::critical(this, "Invalid Timestep", "The value '" + one.trimmed() + "' is not a valid timestep in milliseconds");
+			return;
+		}
+		steps.push_back(ms / 1000.0);
+	}
 
-		std::ofstream outstrm(filename.toStdString());
-		CSVWriter::write<QVector<Pose2dWithTrajectory>::const_iterator>(outstrm, headers, traj->begin(), traj->end());
+	paths_data_model_.setExportTimesteps(steps);
+}
+
+void XeroPathGen::generateOnePath(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QDir &dirobj)
+{
+	QString msg;
+
+	if (group == nullptr)
+		return;
+
+	if (!TrajectoryWriter::write(path, group, dirobj, msg)) {
+		QMessageBox::critical(this, "Error!", "Cannot write the path '" + path->fullname() + "' - " + msg);
 	}
 }
 
@@ -795,21 +915,32 @@ void XeroPathGen::updateStatusBar()
 	}
 }
 
-void XeroPathGen::updateAllPaths(bool wait)
+//
+// Only the paths that read a robot parameter changed since the last update are
+// generated again, so a change that does not affect any trajectory generates nothing
+//
+std::shared_ptr<GenerationBatch> XeroPathGen::updateAllPaths()
 {
-	generator_.clear();
+	auto batch = generator_.updatePaths(paths_data_model_.generatorType(), paths_data_model_.getAllPaths(), robot_changes_);
+	robot_changes_ = 0;
+	return batch;
+}
 
-	for (auto path : paths_data_model_.getAllPaths())
-	{
-		generator_.addPath(paths_data_model_.generatorType(), path);
-	}
+//
+// Waits for a batch of paths to be generated while showing its progress.  The event
+// loop keeps running, so the window stays responsive and the batch can be canceled.
+//
+bool XeroPathGen::waitForBatch(std::shared_ptr<GenerationBatch> batch, const QString& label)
+{
+	QProgressDialog dialog(label, "Cancel", 0, batch->total(), this);
+	dialog.setWindowModality(Qt::WindowModal);
+	dialog.setMinimumDuration(500);
+	dialog.setValue(batch->completed());
 
-	if (wait) {
-		while (!generator_.isEmpty()) {
-			QCoreApplication::processEvents();
-			QThread::msleep(10);
-		}
-	}
+	connect(batch.get(), &GenerationBatch::progress, &dialog, &QProgressDialog::setValue);
+	connect(&dialog, &QProgressDialog::canceled, batch.get(), &GenerationBatch::cancel);
+
+	return batch->wait();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -919,6 +1050,7 @@ void XeroPathGen::setField(const QString &name)
 		action->setChecked(false);
 	}
 	path_edit_win_->setField(current_field_);
+	path_win_->setField(current_field_);
 
 	if (current_field_ != nullptr)
 	{
@@ -954,6 +1086,7 @@ void XeroPathGen::setPath(std::shared_ptr<RobotPath> path)
 {
 	auto trajgrp = generator_.getTrajectoryGroup(path);
 
+	generator_.setSelectedPath(path);
 	path_edit_win_->setPath(path);
 	constraint_win_->setPath(path);
 	waypoint_win_->setPath(path);
@@ -964,7 +1097,11 @@ void XeroPathGen::setPath(std::shared_ptr<RobotPath> path)
 	}
 }
 
-void XeroPathGen::setTrajectoryGroup(std::shared_ptr<TrajectoryGroup> group)
+//
+// When refine is true the group improves on the one displayed for the same generation,
+// so the time selected with the slider is kept rather than reset to the start
+//
+void XeroPathGen::setTrajectoryGroup(std::shared_ptr<TrajectoryGroup> group, bool refine)
 {
 	auto main = group->getTrajectory(TrajectoryName::Main);
 	path_edit_win_->setTrajectory(main);
@@ -986,7 +1123,9 @@ void XeroPathGen::setTrajectoryGroup(std::shared_ptr<TrajectoryGroup> group)
 		waypointSelected(waypoint_win_->getWaypoint());
 
 		path_edit_win_->setTrajectory(main);
-		path_edit_win_slider_->setValue(0);
+		if (!refine) {
+			path_edit_win_slider_->setValue(0);
+		}
 		if (main == nullptr) {
 			path_edit_win_slider_->setMaximum(0);
 		}
@@ -1006,7 +1145,7 @@ void XeroPathGen::setRobot(std::shared_ptr<RobotParams> robot)
 {
 	current_robot_ = robot;
 	path_edit_win_->setRobot(current_robot_);
-	generator_.setRobot(current_robot_);
+	robot_changes_ |= generator_.setRobot(current_robot_);
 	path_win_->setRobot(current_robot_);
 
 	//
@@ -1117,14 +1256,14 @@ void XeroPathGen::newRobotSelected(std::shared_ptr<RobotParams> robot)
 void XeroPathGen::newRobotAction()
 {
 	createEditRobot(nullptr, "");
-	updateAllPaths(false);
+	updateAllPaths();
 }
 
 void XeroPathGen::editRobotAction()
 {
 	createEditRobot(current_robot_, "");
 	setRobot(current_robot_) ;
-	updateAllPaths(false);
+	updateAllPaths();
 }
 
 void XeroPathGen::showRobotMenu()
@@ -1221,21 +1360,37 @@ void XeroPathGen::waypointSelected(int index)
 
 void XeroPathGen::waypointStartMoving(int index)
 {
+	//
+	// While a waypoint is dragged only preview generations are run.  The full generation
+	// is deferred until the waypoint is dropped.
+	//
 	paths_data_model_.enableGeneration(false);
 	waypoint_win_->refresh();
 }
 
 void XeroPathGen::waypointMoving(int index)
 {
+	if (!preview_timer_->isActive()) {
+		preview_timer_->start();
+	}
 	waypoint_win_->refresh();
 }
 
 void XeroPathGen::waypointEndMoving(int index)
 {
+	preview_timer_->stop();
 	paths_data_model_.enableGeneration(true);
 	waypoint_win_->refresh();
 }
 
+void XeroPathGen::generatePreview()
+{
+	auto path = path_win_->selectedPath();
+	if (path != nullptr) {
+		paths_data_model_.generatePreview(path);
+	}
+}
+
 void XeroPathGen::createEditRobot(std::shared_ptr<RobotParams> robot, const QString &path)
 {
 	double elength, ewidth, rlength, rwidth, rweight;
@@ -1459,6 +1614,57 @@ void XeroPathGen::showAbout()
 	about.exec();
 }
 
+void XeroPathGen::recordTrace(bool enabled)
+{
+	//
+	// Each recording starts a new trace
+	//
+	if (enabled) {
+		Tracer::clear();
+	}
+
+	Tracer::setEnabled(enabled);
+}
+
+void XeroPathGen::captureInputs(QAction* action, bool enabled)
+{
+	if (!enabled) {
+		Generator::setCaptureDirectory("");
+		return;
+	}
+
+	QString dir = QFileDialog::getExistingDirectory(this, tr("Capture Directory"));
+	if (dir.length() == 0) {
+		//
+		// Leave capturing off, without calling this again to turn it off
+		//
+		QSignalBlocker blocker(action);
+		action->setChecked(false);
+		return;
+	}
+
+	Generator::setCaptureDirectory(dir);
+	QMessageBox::information(this, "Capturing", "Each path generated will be written to '" + dir + "' as a ." +
+		QString(GenerationCapture::Extension) + " file that xeropath2-replay can run.  Uncheck Help/Capture Generation Inputs to stop.");
+}
+
+void XeroPathGen::saveTrace()
+{
+	if (Tracer::spanCount() == 0) {
+		QMessageBox::information(this, "No Trace", "Nothing has been traced.  Use Help/Record Trace to start recording, then edit or generate paths");
+		return;
+	}
+
+	QString filename = QFileDialog::getSaveFileName(this, tr("Save Trace File"), "", tr("Trace File (*.json);;All Files (*)"));
+	if (filename.length() == 0)
+		return;
+
+	QString msg;
+	if (!Tracer::write(filename, msg)) {
+		QMessageBox::critical(this, "Save Trace Failed", "The trace cannot be saved - " + msg);
+	}
+}
+
 void XeroPathGen::showChanges()
 {
 	QString exedir = QCoreApplication::applicationDirPath();
@@ -1503,7 +1709,7 @@ void XeroPathGen::trajectoryGeneratorChanged()
 	// reflect the udpated data
 	//
 	setPath(path_edit_win_->getPath());
-	updateAllPaths(false);
+	updateAllPaths();
 }
 
 void XeroPathGen::trajectoryGenerationComplete(std::shared_ptr<RobotPath> path)
@@ -1511,7 +1717,59 @@ void XeroPathGen::trajectoryGenerationComplete(std::shared_ptr<RobotPath> path)
 	auto group = generator_.getTrajectoryGroup(path);
 	assert(group != nullptr);
 
-	setTrajectoryGroup(group);
+	bool refine = (refining_ == path);
+	refining_ = nullptr;
+	setTrajectoryGroup(group, refine);
+
+	if (latency_.record(group, Tracer::now()) && latency_overlay_) {
+		path_edit_win_->setOverlayText(latency_.toText());
+	}
+}
+
+void XeroPathGen::trajectoryGenerationProgress(std::shared_ptr<RobotPath> path)
+{
+	//
+	// Only the selected path is shown while it is generated, the others are shown
+	// when they are complete
+	//
+	if (path != path_win_->selectedPath()) {
+		return;
+	}
+
+	auto group = generator_.getTrajectoryGroup(path);
+	if (group == nullptr) {
+		return;
+	}
+
+	bool refine = (refining_ == path);
+	refining_ = path;
+	setTrajectoryGroup(group, refine);
+}
+
+void XeroPathGen::showLatencyOverlay(bool show)
+{
+	latency_overlay_ = show;
+	settings_.setValue(LatencyOverlaySetting, show);
+
+	if (!show) {
+		path_edit_win_->setOverlayText("");
+	}
+	else if (latency_.count() == 0) {
+		path_edit_win_->setOverlayText("edit latency: waiting for an edit");
+	}
+	else {
+		path_edit_win_->setOverlayText(latency_.toText());
+	}
+}
+
+//
+// The error is estimated for the paths generated from now on, it is shown in the
+// generation metrics window
+//
+void XeroPathGen::estimateResolutionError(bool estimate)
+{
+	generator_.setEstimateError(estimate);
+	settings_.setValue(EstimateErrorSetting, estimate);
 }
 
 void XeroPathGen::sliderChanged(int value)
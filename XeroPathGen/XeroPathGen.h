@@ -17,6 +17,8 @@
 
 #include "Logger.h"
 #include "LoggerWindow.h"
+#include "GenerationMetricsWindow.h"
+#include "EditLatency.h"
 #include "GameFieldManager.h"
 #include "RobotManager.h"
 #include "PathFieldView.h"
@@ -31,6 +33,8 @@
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QLabel>
 #include <QtCore/QSettings>
+#include <QtCore/QTimer>
+#include <QtCore/QDir>
 #include <fstream>
 #include <sstream>
 
@@ -61,6 +65,7 @@ private:
     void fileClose();
     void fileGenerateAs();
     void fileGenerate();
+    void fileExportTimesteps();
     void fileExit();
     void recentOpen(const QString& name, const QString& filename);
     void recentOpen(const QString& filename);
@@ -79,6 +84,9 @@ private:
     static constexpr const char* WindowStateSetting = "windowState";
     static constexpr const char* PlotWindowSplitterSize = "plotWindowSplitterSize";
     static constexpr const char* PlotWindowNodeList = "plotWindowNodeList";
+    static constexpr const char* LatencyOverlaySetting = "latencyOverlay";
+    static constexpr const char* TrajectoryBudgetSetting = "trajectoryBudgetMB";
+    static constexpr const char* EstimateErrorSetting = "estimateResolutionError";
 
 private:
     void setDefaultField();
@@ -93,7 +101,7 @@ private:
     void newRobotSelected(std::shared_ptr<RobotParams> robot);
 
     void setPath(std::shared_ptr<RobotPath> path);
-    void setTrajectoryGroup(std::shared_ptr<TrajectoryGroup> group);
+    void setTrajectoryGroup(std::shared_ptr<TrajectoryGroup> group, bool refine = false);
 
     void newRobotAction();
     void editRobotAction();
@@ -113,16 +121,24 @@ private:
     void waypointStartMoving(int index);
     void waypointMoving(int index);
     void waypointEndMoving(int index);
+    void generatePreview();
 
-    void generateOnePath(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group);
+    void generateOnePath(std::shared_ptr<RobotPath> path, std::shared_ptr<TrajectoryGroup> group, const QDir &dir);
     void updateStatusBar();
-    void updateAllPaths(bool wait);
+    std::shared_ptr<GenerationBatch> updateAllPaths();
+    bool waitForBatch(std::shared_ptr<GenerationBatch> batch, const QString& label);
     void createEditRobot(std::shared_ptr<RobotParams> robot, const QString &path);
 
     void showAbout();
     void showChanges();
+    void recordTrace(bool enabled);
+    void captureInputs(QAction* action, bool enabled);
+    void showLatencyOverlay(bool show);
+    void estimateResolutionError(bool estimate);
+    void saveTrace();
     void undo();
 
+    void trajectoryGenerationProgress(std::shared_ptr<RobotPath> path);
     void trajectoryGenerationComplete(std::shared_ptr<RobotPath> path);
     void trajectoryGeneratorChanged();
 
@@ -160,6 +176,7 @@ private:
 
     std::shared_ptr<GameField> current_field_;
     std::shared_ptr<RobotParams> current_robot_;
+    RobotParams::Fields robot_changes_;
 
     std::stringstream& strstream_;
 
@@ -173,6 +190,7 @@ private:
     PlotWindow* plot_win_;
     ConstraintEditorWindow* constraint_win_;
     LoggerWindow* logwin_;
+    GenerationMetricsWindow* metrics_win_;
 
     // Docking windows
     QDockWidget* dock_path_win_;
@@ -181,6 +199,7 @@ private:
     QDockWidget* dock_plot_win_;
     QDockWidget* dock_constraint_win_;
     QDockWidget* dock_logwin_;
+    QDockWidget* dock_metrics_win_;
 
     // Menus
     QMenu* file_menu_;
@@ -215,4 +234,10 @@ private:
     QList<PathsDataModel> undo_stack_;
 
     bool custom_plot_;
+
+    EditLatency latency_;
+    bool latency_overlay_;
+
+    QTimer* preview_timer_;
+    std::shared_ptr<RobotPath> refining_;
 };
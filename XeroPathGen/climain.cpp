@@ -0,0 +1,398 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+// xeropath2-cli - generates all of the paths in a path file or project without
+// a display.  This is meant for build servers and deploy scripts.
+//
+#include "GenerationMgr.h"
+#include "PathsDataModel.h"
+#include "PathGroup.h"
+#include "RobotManager.h"
+#include "TrajectoryNames.h"
+#include "TrajectoryWriter.h"
+#include "Tracer.h"
+#include "Generator.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+
+//
+// Exit codes
+//
+static constexpr int ExitSuccess = 0;
+static constexpr int ExitPathsFailed = 1;
+static constexpr int ExitUsageError = 2;
+
+static void usage()
+{
+	std::cerr << "usage: xeropath2-cli [options] [pathfile]" << std::endl;
+	std::cerr << "    --project DIR        generate the paths in a robot project, the path file, robot file" << std::endl;
+	std::cerr << "                         and output directory are taken from the project" << std::endl;
+	std::cerr << "    --robot FILE         the robot JSON file (required unless --project is given)" << std::endl;
+	std::cerr << "    --output DIR         the output directory, overrides the directory in the path file" << std::endl;
+	std::cerr << "    --jobs N             the number of paths to generate at the same time (default: all cores)" << std::endl;
+	std::cerr << "    --json-report FILE   write a JSON report of the results of each path to FILE" << std::endl;
+	std::cerr << "    --timing             print the time taken to generate each path" << std::endl;
+	std::cerr << "    --trace FILE         write a Chrome trace (chrome://tracing or Perfetto) of the run to FILE" << std::endl;
+	std::cerr << "    --capture DIR        write the inputs of each generation to a replay file in DIR for xeropath2-replay" << std::endl;
+	std::cerr << "    --estimate-error     print the position and velocity error of each path against a much finer" << std::endl;
+	std::cerr << "                         resolution than the one in the path file" << std::endl;
+	std::cerr << "    --help               print this message" << std::endl;
+	std::cerr << std::endl;
+	std::cerr << "exit status is 0 on success, 1 if any path failed to generate, and 2 on a usage or load error" << std::endl;
+}
+
+static bool makeDirectory(const QDir& dir)
+{
+	if (!dir.exists() && !dir.mkpath(dir.absolutePath())) {
+		std::cerr << "xeropath2-cli: cannot create the output directory '" << dir.absolutePath().toStdString() << "'" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication a(argc, argv);
+
+	QCoreApplication::setOrganizationName("ErrorCodeXero");
+	QCoreApplication::setOrganizationDomain("www.wilsonvillerobotics.com");
+	QCoreApplication::setApplicationName("XeroPathGenerator");
+	QCoreApplication::setApplicationVersion("1.0.0");
+
+	QString pathfile, robotfile, outdir, project, reportfile, tracefile, capturedir;
+	int jobs = 0;
+	bool timing = false;
+	bool estimate = false;
+
+	QStringList args = QCoreApplication::arguments();
+	args.pop_front();
+
+	while (args.size() > 0)
+	{
+		QString arg = args.takeFirst();
+
+		if (arg == "--help")
+		{
+			usage();
+			return ExitSuccess;
+		}
+		else if (arg == "--timing")
+		{
+			timing = true;
+		}
+		else if (arg == "--estimate-error")
+		{
+			estimate = true;
+		}
+		else if (arg == "--project" || arg == "--robot" || arg == "--output" || arg == "--jobs" || arg == "--json-report" || arg == "--trace" || arg == "--capture")
+		{
+			if (args.size() == 0)
+			{
+				std::cerr << "xeropath2-cli: " << arg.toStdString() << " flag requires an argument" << std::endl;
+				return ExitUsageError;
+			}
+
+			QString value = args.takeFirst();
+			if (arg == "--project")
+			{
+				project = value;
+			}
+			else if (arg == "--robot")
+			{
+				robotfile = value;
+			}
+			else if (arg == "--output")
+			{
+				outdir = value;
+			}
+			else if (arg == "--json-report")
+			{
+				reportfile = value;
+			}
+			else if (arg == "--trace")
+			{
+				tracefile = value;
+			}
+			else if (arg == "--capture")
+			{
+				capturedir = value;
+			}
+			else
+			{
+				bool ok;
+				jobs = value.toInt(&ok);
+				if (!ok || jobs < 1)
+				{
+					std::cerr << "xeropath2-cli: --jobs requires a positive integer" << std::endl;
+					return ExitUsageError;
+				}
+			}
+		}
+		else if (arg.startsWith("--") || pathfile.length() > 0)
+		{
+			std::cerr << "xeropath2-cli: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return ExitUsageError;
+		}
+		else
+		{
+			pathfile = arg;
+		}
+	}
+
+	Tracer::setEnabled(tracefile.length() > 0);
+
+	if (capturedir.length() > 0)
+	{
+		if (!makeDirectory(QDir(capturedir)))
+			return ExitUsageError;
+
+		Generator::setCaptureDirectory(QDir(capturedir).absolutePath());
+	}
+
+	//
+	// A project has the same fixed layout that the GUI uses when a project is opened
+	//
+	if (project.length() > 0)
+	{
+		if (pathfile.length() == 0)
+			pathfile = project + "/src/main/paths/robot.xeropath";
+
+		if (robotfile.length() == 0)
+			robotfile = project + "/src/main/paths/robot.json";
+
+		if (outdir.length() == 0)
+			outdir = project + "/src/main/deploy/paths";
+	}
+
+	if (pathfile.length() == 0 || robotfile.length() == 0)
+	{
+		usage();
+		return ExitUsageError;
+	}
+
+	RobotManager robots;
+	std::shared_ptr<RobotParams> robot;
+	try {
+		QFile file(robotfile);
+		robot = robots.load(file);
+	}
+	catch (const std::runtime_error& ex) {
+		std::cerr << "xeropath2-cli: cannot load robot file '" << robotfile.toStdString() << "' - " << ex.what() << std::endl;
+		return ExitUsageError;
+	}
+
+	if (robot == nullptr)
+	{
+		std::cerr << "xeropath2-cli: cannot load robot file '" << robotfile.toStdString() << "'" << std::endl;
+		return ExitUsageError;
+	}
+
+	//
+	// The robot is given to the generation manager after the path file is loaded so that
+	// loading does not start generating paths one at a time
+	//
+	GenerationMgr genmgr;
+	PathsDataModel model(genmgr);
+	QString msg;
+
+	if (!model.load(pathfile, msg))
+	{
+		std::cerr << "xeropath2-cli: cannot load path file '" << pathfile.toStdString() << "' - " << msg.toStdString() << std::endl;
+		return ExitUsageError;
+	}
+
+	if (outdir.length() == 0)
+	{
+		if (!model.hasOutpuDir())
+		{
+			std::cerr << "xeropath2-cli: the path file has no output directory, use --output" << std::endl;
+			return ExitUsageError;
+		}
+		outdir = model.outputDir();
+	}
+
+	QDir dirobj(outdir);
+	if (!makeDirectory(dirobj))
+		return ExitUsageError;
+
+	if (jobs > 0)
+		genmgr.setThreadCount(jobs);
+
+	genmgr.setEstimateError(estimate);
+	genmgr.setRobot(robot);
+
+	//
+	// Generate every path, and wait for them all to complete
+	//
+	QElapsedTimer timer;
+	timer.start();
+
+	auto paths = model.getAllPaths();
+	auto batch = genmgr.addPaths(model.generatorType(), paths);
+	batch->wait();
+
+	double elapsed = timer.nsecsElapsed() / 1.0e9;
+
+	//
+	// Write the results for each path
+	//
+	int failed = 0;
+	QJsonArray results;
+
+	for (auto path : paths)
+	{
+		auto group = batch->group(path);
+		QJsonObject result;
+		QString error;
+
+		if (group == nullptr)
+		{
+			error = "the path was not generated";
+		}
+		else if (group->hasError())
+		{
+			error = group->errorMessage();
+		}
+		else if (group->getTrajectory(TrajectoryName::Main) == nullptr)
+		{
+			error = "the path generated no trajectory";
+		}
+		else if (!TrajectoryWriter::write(path, group, dirobj, msg))
+		{
+			error = msg;
+		}
+
+		result["group"] = path->pathGroup()->name();
+		result["path"] = path->name();
+		result["status"] = (error.length() > 0) ? "failed" : "ok";
+		if (error.length() > 0)
+		{
+			result["error"] = error;
+			failed++;
+			std::cerr << "xeropath2-cli: path '" << path->fullname().toStdString() << "' failed - " << error.toStdString() << std::endl;
+		}
+
+		if (group != nullptr)
+		{
+			auto main = group->getTrajectory(TrajectoryName::Main);
+			result["time"] = group->generationTime();
+			if (main != nullptr)
+			{
+				result["points"] = main->size();
+				result["duration"] = main->getEndTime();
+			}
+
+			if (timing)
+			{
+				std::cout << path->fullname().toStdString() << ": " << QString::number(group->generationTime() * 1000.0, 'f', 1).toStdString() << " ms" << std::endl;
+			}
+
+			if (group->hasResolutionError())
+			{
+				const TrajectoryGroup::ResolutionError& res = group->resolutionError();
+				QJsonObject obj;
+				obj["position"] = res.position;
+				obj["velocity"] = res.velocity;
+				obj["duration"] = res.duration;
+				result["resolutionerror"] = obj;
+
+				std::cout << path->fullname().toStdString() << ": position error " << res.position << " " << path->units().toStdString() <<
+					", velocity error " << res.velocity << " " << path->units().toStdString() << "/s, duration error " << res.duration << " s" << std::endl;
+			}
+		}
+
+		results.append(result);
+	}
+
+	//
+	// Any additional timesteps are resampled from the trajectories just generated
+	// and each is written to its own directory under the output directory, just like the GUI
+	//
+	for (double step : model.exportTimesteps())
+	{
+		if (std::fabs(step - genmgr.timestep()) < 1e-9)
+			continue;
+
+		QDir stepdir = QDir(dirobj.absoluteFilePath(QString::number(step * 1000.0) + "ms"));
+		if (!makeDirectory(stepdir))
+			return ExitUsageError;
+
+		for (auto path : paths)
+		{
+			auto group = batch->group(path);
+			if (group == nullptr || group->hasError())
+				continue;
+
+			auto resampled = group->resample(step, robot);
+			if (resampled == nullptr || !TrajectoryWriter::write(path, resampled, stepdir, msg))
+			{
+				std::cerr << "xeropath2-cli: path '" << path->fullname().toStdString() << "' failed at timestep " << step << std::endl;
+				failed++;
+			}
+		}
+	}
+
+	if (timing)
+	{
+		std::cout << "total: " << paths.size() << " paths in " << QString::number(elapsed * 1000.0, 'f', 1).toStdString() << " ms using " << genmgr.threadCount() << " threads" << std::endl;
+	}
+
+	if (tracefile.length() > 0)
+	{
+		QString msg;
+		if (!Tracer::write(tracefile, msg))
+		{
+			std::cerr << "xeropath2-cli: " << msg.toStdString() << std::endl;
+			return ExitUsageError;
+		}
+	}
+
+	if (reportfile.length() > 0)
+	{
+		QJsonObject report;
+		report["pathfile"] = QFileInfo(pathfile).absoluteFilePath();
+		report["robot"] = robot->getName();
+		report["output"] = dirobj.absolutePath();
+		report["jobs"] = genmgr.threadCount();
+		report["resolution"] = presetToKey(model.resolutionPreset());
+		report["adaptive"] = model.isAdaptive();
+		report["time"] = elapsed;
+		report["failed"] = failed;
+		report["paths"] = results;
+
+		QFile file(reportfile);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			std::cerr << "xeropath2-cli: cannot write the report file '" << reportfile.toStdString() << "'" << std::endl;
+			return ExitUsageError;
+		}
+		file.write(QJsonDocument(report).toJson());
+		file.close();
+	}
+
+	return (failed > 0) ? ExitPathsFailed : ExitSuccess;
+}
@@ -0,0 +1,90 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "Corpus.h"
+#include "RobotManager.h"
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <stdexcept>
+
+Corpus::Corpus()
+{
+}
+
+bool Corpus::load(const QString& dir, QString& msg)
+{
+	QDir dirobj(dir);
+	QFile file(dirobj.absoluteFilePath(ManifestName));
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		msg = "cannot open corpus manifest '" + file.fileName() + "'";
+		return false;
+	}
+
+	QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+	file.close();
+
+	if (!doc.isObject() || !doc.object().value(CasesTag).isArray())
+	{
+		msg = "corpus manifest '" + file.fileName() + "' does not contain a '" + CasesTag + "' array";
+		return false;
+	}
+
+	dir_ = dirobj.absolutePath();
+	cases_.clear();
+
+	for (const QJsonValue& v : doc.object().value(CasesTag).toArray())
+	{
+		QJsonObject obj = v.toObject();
+		if (!obj.value(NameTag).isString() || !obj.value(PathsTag).isString() || !obj.value(RobotTag).isString())
+		{
+			msg = "corpus manifest '" + file.fileName() + "' has a case without '" + NameTag + "', '" + PathsTag + "' and '" + RobotTag + "' strings";
+			return false;
+		}
+
+		Case c;
+		c.name = obj.value(NameTag).toString();
+		c.pathfile = dirobj.absoluteFilePath(obj.value(PathsTag).toString());
+		c.robotfile = dirobj.absoluteFilePath(obj.value(RobotTag).toString());
+		cases_.push_back(c);
+	}
+
+	return true;
+}
+
+std::shared_ptr<RobotParams> Corpus::loadRobot(const QString& filename, QString& msg)
+{
+	RobotManager robots;
+	std::shared_ptr<RobotParams> robot;
+
+	try {
+		QFile file(filename);
+		robot = robots.load(file);
+	}
+	catch (const std::runtime_error& ex) {
+		msg = "cannot load robot file '" + filename + "' - " + ex.what();
+		return nullptr;
+	}
+
+	if (robot == nullptr) {
+		msg = "cannot load robot file '" + filename + "'";
+	}
+
+	return robot;
+}
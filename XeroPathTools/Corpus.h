@@ -0,0 +1,61 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "RobotParams.h"
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <memory>
+
+//
+// A corpus is a directory of path files and robot files, described by a corpus.json
+// manifest that pairs each path file with the robot used to generate it.
+//
+class Corpus
+{
+public:
+	static constexpr const char* ManifestName = "corpus.json";
+	static constexpr const char* CasesTag = "cases";
+	static constexpr const char* NameTag = "name";
+	static constexpr const char* PathsTag = "paths";
+	static constexpr const char* RobotTag = "robot";
+
+	struct Case
+	{
+		QString name;
+		QString pathfile;
+		QString robotfile;
+	};
+
+public:
+	Corpus();
+
+	bool load(const QString& dir, QString& msg);
+
+	const QString& dir() const {
+		return dir_;
+	}
+
+	const QVector<Case>& cases() const {
+		return cases_;
+	}
+
+	static std::shared_ptr<RobotParams> loadRobot(const QString& filename, QString& msg);
+
+private:
+	QString dir_;
+	QVector<Case> cases_;
+};
@@ -0,0 +1,356 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+// xeropath2-bench - times each stage of path generation over the paths in a corpus
+// and reports the results as JSON.
+//
+#include "AllocationCounter.h"
+#include "Corpus.h"
+#include "GenerationMgr.h"
+#include "Generator.h"
+#include "GeneratorStats.h"
+#include "PathsDataModel.h"
+#include "PathGroup.h"
+#include "TrajectoryNames.h"
+#include "TrajectoryWriter.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static void usage()
+{
+	std::cerr << "usage: xeropath2-bench [options]" << std::endl;
+	std::cerr << "    --corpus DIR         the corpus directory holding corpus.json (default: corpus)" << std::endl;
+	std::cerr << "    --iterations N       the number of timed generations of each path (default: 20)" << std::endl;
+	std::cerr << "    --warmup N           the number of untimed generations of each path first (default: 2)" << std::endl;
+	std::cerr << "    --filter TEXT        only run cases whose name contains TEXT" << std::endl;
+	std::cerr << "    --output FILE        write the JSON results to FILE rather than stdout" << std::endl;
+	std::cerr << "    --allocations        count the heap allocations of each path (needs -DXEROPATH_ALLOC_TRACKING=ON)" << std::endl;
+	std::cerr << "    --alloc-baseline F   with --allocations, fail if a path makes more allocations than in the" << std::endl;
+	std::cerr << "                         results file F from an earlier run" << std::endl;
+}
+
+//
+// Returns the percentile (0 - 100) of a sorted set of samples using the nearest rank
+//
+static double percentile(const QVector<qint64>& sorted, double pct)
+{
+	if (sorted.size() == 0)
+		return 0.0;
+
+	int rank = static_cast<int>(std::ceil(pct / 100.0 * sorted.size()));
+	rank = std::clamp(rank, 1, static_cast<int>(sorted.size()));
+	return sorted[rank - 1] / 1.0e6;
+}
+
+static QJsonObject summarize(QVector<qint64> samples, int calls)
+{
+	QJsonObject obj;
+	double total = 0.0;
+
+	std::sort(samples.begin(), samples.end());
+	for (qint64 v : samples)
+		total += v / 1.0e6;
+
+	obj["calls"] = calls;
+	obj["min"] = percentile(samples, 0.0);
+	obj["mean"] = (samples.size() > 0) ? total / samples.size() : 0.0;
+	obj["p50"] = percentile(samples, 50.0);
+	obj["p90"] = percentile(samples, 90.0);
+	obj["p99"] = percentile(samples, 99.0);
+	obj["max"] = percentile(samples, 100.0);
+
+	return obj;
+}
+
+static QJsonObject benchmarkPath(std::shared_ptr<RobotPath> path, GeneratorType type, std::shared_ptr<RobotParams> robot, double timestep,
+	int iterations, int warmup, const QString& logfile, QMutex& loglock, const QDir& outdir)
+{
+	QJsonObject result;
+	QVector<qint64> generate, csv;
+	QVector<qint64> stages[GeneratorStats::StageCount];
+	GeneratorStats calls;
+	std::shared_ptr<TrajectoryGroup> group;
+	QString msg;
+
+	for (int i = 0; i < warmup + iterations; i++)
+	{
+		QElapsedTimer timer;
+
+		group = std::make_shared<TrajectoryGroup>(type, path);
+		Generator gen(logfile, loglock, timestep, robot, group);
+
+		timer.start();
+		gen.generateTrajectory();
+		qint64 gentime = timer.nsecsElapsed();
+
+		if (group->hasError())
+		{
+			result["status"] = "failed";
+			result["error"] = group->errorMessage();
+			return result;
+		}
+
+		timer.start();
+		if (!TrajectoryWriter::write(path, group, outdir, msg))
+		{
+			result["status"] = "failed";
+			result["error"] = msg;
+			return result;
+		}
+		qint64 csvtime = timer.nsecsElapsed();
+
+		if (i < warmup)
+			continue;
+
+		generate.push_back(gentime);
+		csv.push_back(csvtime);
+		for (int s = 0; s < GeneratorStats::StageCount; s++) {
+			stages[s].push_back(group->stats().nsecs(static_cast<GeneratorStats::Stage>(s)));
+		}
+		calls = group->stats();
+	}
+
+	QJsonObject timings;
+	timings["generate"] = summarize(generate, 1);
+	timings["export"] = summarize(csv, group->trajectoryNames().size());
+	for (int s = 0; s < GeneratorStats::StageCount; s++) {
+		auto stage = static_cast<GeneratorStats::Stage>(s);
+		timings[GeneratorStats::stageName(stage)] = summarize(stages[s], calls.calls(stage));
+	}
+
+	if (AllocationCounter::isEnabled())
+	{
+		QJsonObject allocs;
+		allocs["allocations"] = group->allocations().allocations;
+		allocs["bytes"] = group->allocations().bytes;
+		allocs["peak"] = group->allocations().peak;
+		result["allocations"] = allocs;
+	}
+
+	auto main = group->getTrajectory(TrajectoryName::Main);
+	result["status"] = "ok";
+	result["points"] = main->size();
+	result["duration"] = main->getEndTime();
+	result["timings"] = timings;
+
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication a(argc, argv);
+
+	QString corpusdir = "corpus";
+	QString outfile, filter, baselinefile;
+	bool allocations = false;
+	int iterations = 20;
+	int warmup = 2;
+
+	QStringList args = QCoreApplication::arguments();
+	args.pop_front();
+
+	while (args.size() > 0)
+	{
+		QString arg = args.takeFirst();
+
+		if (arg == "--help")
+		{
+			usage();
+			return 0;
+		}
+		else if (arg == "--allocations")
+		{
+			allocations = true;
+		}
+		else if (arg == "--corpus" || arg == "--iterations" || arg == "--warmup" || arg == "--filter" || arg == "--output" || arg == "--alloc-baseline")
+		{
+			if (args.size() == 0)
+			{
+				std::cerr << "xeropath2-bench: " << arg.toStdString() << " flag requires an argument" << std::endl;
+				return 2;
+			}
+
+			QString value = args.takeFirst();
+			bool ok = true;
+
+			if (arg == "--corpus")
+				corpusdir = value;
+			else if (arg == "--filter")
+				filter = value;
+			else if (arg == "--output")
+				outfile = value;
+			else if (arg == "--alloc-baseline")
+				baselinefile = value;
+			else if (arg == "--iterations")
+			{
+				iterations = value.toInt(&ok);
+				ok = ok && iterations > 0;
+			}
+			else
+			{
+				warmup = value.toInt(&ok);
+				ok = ok && warmup >= 0;
+			}
+
+			if (!ok)
+			{
+				std::cerr << "xeropath2-bench: " << arg.toStdString() << " requires a valid count" << std::endl;
+				return 2;
+			}
+		}
+		else
+		{
+			std::cerr << "xeropath2-bench: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return 2;
+		}
+	}
+
+	if (allocations && !AllocationCounter::isAvailable())
+	{
+		std::cerr << "xeropath2-bench: --allocations needs a build configured with -DXEROPATH_ALLOC_TRACKING=ON" << std::endl;
+		return 2;
+	}
+	AllocationCounter::setEnabled(allocations);
+
+	//
+	// The allocation counts of each case from an earlier run, which this run may not exceed
+	//
+	QMap<QString, qint64> baseline;
+	if (baselinefile.length() > 0)
+	{
+		QFile file(baselinefile);
+		if (!allocations || !file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			std::cerr << "xeropath2-bench: --alloc-baseline needs --allocations and a readable results file" << std::endl;
+			return 2;
+		}
+
+		QJsonArray list = QJsonDocument::fromJson(file.readAll()).object().value("cases").toArray();
+		for (const QJsonValue& v : list)
+		{
+			QJsonObject obj = v.toObject();
+			if (obj.contains("allocations"))
+				baseline.insert(obj.value("name").toString(), obj.value("allocations").toObject().value("allocations").toInteger());
+		}
+	}
+
+	Corpus corpus;
+	QString msg;
+	if (!corpus.load(corpusdir, msg))
+	{
+		std::cerr << "xeropath2-bench: " << msg.toStdString() << std::endl;
+		return 2;
+	}
+
+	QTemporaryDir tmpdir;
+	if (!tmpdir.isValid())
+	{
+		std::cerr << "xeropath2-bench: cannot create a temporary directory for the CSV files" << std::endl;
+		return 2;
+	}
+
+	QDir outdir(tmpdir.path());
+	QString logfile = outdir.absoluteFilePath("generators_log.txt");
+	QMutex loglock;
+	QJsonArray cases;
+	int failed = 0;
+
+	for (const Corpus::Case& c : corpus.cases())
+	{
+		auto robot = Corpus::loadRobot(c.robotfile, msg);
+		if (robot == nullptr)
+		{
+			std::cerr << "xeropath2-bench: " << msg.toStdString() << std::endl;
+			return 2;
+		}
+
+		GenerationMgr genmgr;
+		PathsDataModel model(genmgr);
+		if (!model.load(c.pathfile, msg))
+		{
+			std::cerr << "xeropath2-bench: cannot load path file '" << c.pathfile.toStdString() << "' - " << msg.toStdString() << std::endl;
+			return 2;
+		}
+
+		for (auto path : model.getAllPaths())
+		{
+			QString name = c.name + "/" + path->pathGroup()->name() + "/" + path->name();
+			if (filter.length() > 0 && !name.contains(filter))
+				continue;
+
+			std::cerr << "running " << name.toStdString() << std::endl;
+
+			QJsonObject result = benchmarkPath(path, model.generatorType(), robot, genmgr.timestep(), iterations, warmup, logfile, loglock, outdir);
+			result["name"] = name;
+			result["drive"] = (robot->getDriveType() == RobotParams::DriveType::TankDrive) ? "tank" : "swerve";
+			result["generator"] = typeToKey(model.generatorType());
+			result["waypoints"] = path->size();
+
+			if (result["status"].toString() != "ok")
+				failed++;
+
+			if (baseline.contains(name) && result.contains("allocations"))
+			{
+				qint64 count = result["allocations"].toObject().value("allocations").toInteger();
+				if (count > baseline.value(name))
+				{
+					std::cerr << name.toStdString() << ": " << count << " allocations, baseline is " << baseline.value(name) << std::endl;
+					result["status"] = "allocations";
+					failed++;
+				}
+			}
+
+			cases.append(result);
+		}
+	}
+
+	QJsonObject report;
+	report["iterations"] = iterations;
+	report["warmup"] = warmup;
+	report["unit"] = "ms";
+	report["allocations"] = allocations;
+	report["cases"] = cases;
+
+	QByteArray text = QJsonDocument(report).toJson();
+	if (outfile.length() > 0)
+	{
+		QFile file(outfile);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			std::cerr << "xeropath2-bench: cannot write '" << outfile.toStdString() << "'" << std::endl;
+			return 2;
+		}
+		file.write(text);
+		file.close();
+	}
+	else
+	{
+		std::cout << text.toStdString();
+	}
+
+	return (failed > 0) ? 1 : 0;
+}
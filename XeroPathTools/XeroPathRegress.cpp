@@ -0,0 +1,450 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+// xeropath2-regress - generates every path in a corpus and compares the output with
+// the golden CSV files recorded for the corpus, and the generation time with the
+// recorded time budget for each path.
+//
+#include "Corpus.h"
+#include "GenerationMgr.h"
+#include "Generator.h"
+#include "PathsDataModel.h"
+#include "PathGroup.h"
+#include "TrajectoryWriter.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static constexpr const char* GoldenDirName = "golden";
+static constexpr const char* BudgetsFileName = "budgets.json";
+
+struct Options
+{
+	QString corpusdir = "corpus";
+	bool record = false;
+	int iterations = 3;
+	double abstol = 1.0e-3;
+	double reltol = 1.0e-4;
+	double margin = 0.5;
+	double slack = 5.0;
+};
+
+static void usage()
+{
+	std::cerr << "usage: xeropath2-regress [options]" << std::endl;
+	std::cerr << "    --corpus DIR         the corpus directory holding corpus.json (default: corpus)" << std::endl;
+	std::cerr << "    --record             record the golden files and time budgets rather than checking them" << std::endl;
+	std::cerr << "    --iterations N       generations of each path, the median time is used (default: 3)" << std::endl;
+	std::cerr << "    --abs-tol V          absolute tolerance for each value (default: 1e-3)" << std::endl;
+	std::cerr << "    --rel-tol V          relative tolerance for each value (default: 1e-4)" << std::endl;
+	std::cerr << "    --time-margin V      fraction a path may exceed its time budget by (default: 0.5)" << std::endl;
+	std::cerr << "    --time-slack V       milliseconds a path may always exceed its time budget by (default: 5)" << std::endl;
+	std::cerr << std::endl;
+	std::cerr << "exit status is 0 if every path matches, 1 if any path fails and 2 on a usage or load error" << std::endl;
+}
+
+//
+// Reads a CSV file written by CSVWriter into its header and rows of values.  Every
+// row must have one value per column.
+//
+static bool readCSV(const QString& filename, QStringList& headers, QVector<QVector<double>>& rows, QString& msg)
+{
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		msg = "cannot open '" + filename + "'";
+		return false;
+	}
+
+	QTextStream strm(&file);
+	headers.clear();
+	rows.clear();
+
+	if (strm.atEnd())
+	{
+		msg = "'" + filename + "' is empty";
+		return false;
+	}
+
+	for (const QString& h : strm.readLine().split(","))
+		headers.push_back(h.trimmed().remove('"'));
+
+	while (!strm.atEnd())
+	{
+		QString line = strm.readLine().trimmed();
+		if (line.length() == 0)
+			continue;
+
+		QVector<double> row;
+		for (const QString& v : line.split(","))
+		{
+			bool ok;
+			row.push_back(v.toDouble(&ok));
+			if (!ok)
+			{
+				msg = "'" + filename + "' has a value '" + v + "' that is not a number";
+				return false;
+			}
+		}
+
+		if (row.size() != headers.size())
+		{
+			msg = "'" + filename + "' row " + QString::number(rows.size() + 1) + " has " + QString::number(row.size()) +
+				" values, expected " + QString::number(headers.size());
+			return false;
+		}
+
+		rows.push_back(row);
+	}
+
+	return true;
+}
+
+static bool compareCSV(const QString& golden, const QString& actual, const Options& opts, QString& msg)
+{
+	QStringList gheaders, aheaders;
+	QVector<QVector<double>> grows, arows;
+
+	if (!readCSV(golden, gheaders, grows, msg) || !readCSV(actual, aheaders, arows, msg))
+		return false;
+
+	if (gheaders != aheaders)
+	{
+		msg = "columns differ, expected '" + gheaders.join(",") + "' got '" + aheaders.join(",") + "'";
+		return false;
+	}
+
+	if (grows.size() != arows.size())
+	{
+		msg = "row count differs, expected " + QString::number(grows.size()) + " got " + QString::number(arows.size());
+		return false;
+	}
+
+	for (int r = 0; r < grows.size(); r++)
+	{
+		for (int c = 0; c < gheaders.size(); c++)
+		{
+			double expected = grows[r][c];
+			double value = arows[r][c];
+			double tol = opts.abstol + opts.reltol * std::fabs(expected);
+
+			if (!(std::fabs(expected - value) <= tol))
+			{
+				msg = "column '" + gheaders[c] + "' row " + QString::number(r + 1) + " expected " + QString::number(expected, 'g', 10) +
+					" got " + QString::number(value, 'g', 10);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//
+// Generates the path the given number of times, returning the last group and the median time
+//
+static std::shared_ptr<TrajectoryGroup> generate(std::shared_ptr<RobotPath> path, GeneratorType type, std::shared_ptr<RobotParams> robot,
+	double timestep, int iterations, const QString& logfile, QMutex& loglock, double& median)
+{
+	QVector<double> times;
+	std::shared_ptr<TrajectoryGroup> group;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		group = std::make_shared<TrajectoryGroup>(type, path);
+		Generator gen(logfile, loglock, timestep, robot, group);
+
+		QElapsedTimer timer;
+		timer.start();
+		gen.generateTrajectory();
+		times.push_back(timer.nsecsElapsed() / 1.0e9);
+
+		if (group->hasError())
+			break;
+	}
+
+	std::sort(times.begin(), times.end());
+	median = times[times.size() / 2];
+	return group;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication a(argc, argv);
+	Options opts;
+
+	QStringList args = QCoreApplication::arguments();
+	args.pop_front();
+
+	while (args.size() > 0)
+	{
+		QString arg = args.takeFirst();
+
+		if (arg == "--help")
+		{
+			usage();
+			return 0;
+		}
+		else if (arg == "--record")
+		{
+			opts.record = true;
+		}
+		else if (arg == "--corpus" || arg == "--iterations" || arg == "--abs-tol" || arg == "--rel-tol" || arg == "--time-margin" || arg == "--time-slack")
+		{
+			if (args.size() == 0)
+			{
+				std::cerr << "xeropath2-regress: " << arg.toStdString() << " flag requires an argument" << std::endl;
+				return 2;
+			}
+
+			QString value = args.takeFirst();
+			bool ok = true;
+
+			if (arg == "--corpus")
+			{
+				opts.corpusdir = value;
+			}
+			else if (arg == "--iterations")
+			{
+				opts.iterations = value.toInt(&ok);
+				ok = ok && opts.iterations > 0;
+			}
+			else
+			{
+				double v = value.toDouble(&ok);
+				ok = ok && v >= 0.0;
+
+				if (arg == "--abs-tol")
+					opts.abstol = v;
+				else if (arg == "--rel-tol")
+					opts.reltol = v;
+				else if (arg == "--time-margin")
+					opts.margin = v;
+				else
+					opts.slack = v;
+			}
+
+			if (!ok)
+			{
+				std::cerr << "xeropath2-regress: invalid value '" << value.toStdString() << "' for " << arg.toStdString() << std::endl;
+				return 2;
+			}
+		}
+		else
+		{
+			std::cerr << "xeropath2-regress: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return 2;
+		}
+	}
+
+	Corpus corpus;
+	QString msg;
+	if (!corpus.load(opts.corpusdir, msg))
+	{
+		std::cerr << "xeropath2-regress: " << msg.toStdString() << std::endl;
+		return 2;
+	}
+
+	QTemporaryDir tmpdir;
+	if (!tmpdir.isValid())
+	{
+		std::cerr << "xeropath2-regress: cannot create a temporary directory" << std::endl;
+		return 2;
+	}
+
+	QString logfile = QDir(tmpdir.path()).absoluteFilePath("generators_log.txt");
+	QMutex loglock;
+	int failed = 0, passed = 0;
+
+	for (const Corpus::Case& c : corpus.cases())
+	{
+		auto robot = Corpus::loadRobot(c.robotfile, msg);
+		if (robot == nullptr)
+		{
+			std::cerr << "xeropath2-regress: " << msg.toStdString() << std::endl;
+			return 2;
+		}
+
+		GenerationMgr genmgr;
+		//
+		// The loader treats any message as an error, and a failed comparison leaves one behind
+		//
+		msg.clear();
+
+		PathsDataModel model(genmgr);
+		if (!model.load(c.pathfile, msg))
+		{
+			std::cerr << "xeropath2-regress: cannot load path file '" << c.pathfile.toStdString() << "' - " << msg.toStdString() << std::endl;
+			return 2;
+		}
+
+		QDir golddir(QDir(corpus.dir()).absoluteFilePath(QString(GoldenDirName) + "/" + c.name));
+		QDir outdir(QDir(tmpdir.path()).absoluteFilePath(c.name));
+		QDir& writedir = opts.record ? golddir : outdir;
+
+		if (!writedir.exists() && !writedir.mkpath(writedir.absolutePath()))
+		{
+			std::cerr << "xeropath2-regress: cannot create directory '" << writedir.absolutePath().toStdString() << "'" << std::endl;
+			return 2;
+		}
+
+		//
+		// Golden files of paths that are no longer in the corpus must not outlive a new recording
+		//
+		if (opts.record)
+		{
+			for (const QString& file : golddir.entryList(QStringList() << "*.csv", QDir::Files))
+				golddir.remove(file);
+		}
+
+		//
+		// The budgets are the median generation time in seconds of each path when the golden files were recorded
+		//
+		QJsonObject budgets;
+		QFile budgetfile(golddir.absoluteFilePath(BudgetsFileName));
+		if (!opts.record)
+		{
+			if (!budgetfile.open(QIODevice::ReadOnly | QIODevice::Text))
+			{
+				std::cerr << "xeropath2-regress: case '" << c.name.toStdString() << "' has no golden files, run with --record first" << std::endl;
+				failed++;
+				continue;
+			}
+			budgets = QJsonDocument::fromJson(budgetfile.readAll()).object();
+			budgetfile.close();
+		}
+
+		for (auto path : model.getAllPaths())
+		{
+			QString name = path->pathGroup()->name() + "-" + path->name();
+			QString what = c.name + "/" + name;
+			double median;
+
+			auto group = generate(path, model.generatorType(), robot, genmgr.timestep(), opts.iterations, logfile, loglock, median);
+			if (group->hasError())
+			{
+				std::cerr << "FAIL " << what.toStdString() << ": " << group->errorMessage().toStdString() << std::endl;
+				failed++;
+				continue;
+			}
+
+			if (!TrajectoryWriter::write(path, group, writedir, msg))
+			{
+				std::cerr << "FAIL " << what.toStdString() << ": " << msg.toStdString() << std::endl;
+				failed++;
+				continue;
+			}
+
+			if (opts.record)
+			{
+				budgets[name] = median;
+				std::cout << "recorded " << what.toStdString() << " (" << QString::number(median * 1000.0, 'f', 1).toStdString() << " ms)" << std::endl;
+				continue;
+			}
+
+			QString error;
+			for (const QString& trajname : group->trajectoryNames())
+			{
+				QString filename = name + "-" + trajname + ".csv";
+				if (!golddir.exists(filename))
+				{
+					error = filename + ": no golden file";
+					break;
+				}
+
+				if (!compareCSV(golddir.absoluteFilePath(filename), outdir.absoluteFilePath(filename), opts, msg))
+				{
+					error = filename + ": " + msg;
+					break;
+				}
+			}
+
+			if (error.length() == 0)
+			{
+				if (!budgets.contains(name))
+				{
+					error = "no time budget recorded";
+				}
+				else
+				{
+					//
+					// Short paths are timed to a fraction of a millisecond, where scheduling noise alone is
+					// more than the margin, so a path also has to be over its budget by the slack to fail
+					//
+					double budget = budgets.value(name).toDouble();
+					if (median > budget * (1.0 + opts.margin) && median > budget + opts.slack / 1000.0)
+					{
+						error = "took " + QString::number(median * 1000.0, 'f', 1) + " ms, budget is " + QString::number(budget * 1000.0, 'f', 1) +
+							" ms plus " + QString::number(opts.margin * 100.0, 'f', 0) + "% and " + QString::number(opts.slack, 'f', 1) + " ms";
+					}
+				}
+			}
+
+			if (error.length() > 0)
+			{
+				std::cerr << "FAIL " << what.toStdString() << ": " << error.toStdString() << std::endl;
+				failed++;
+			}
+			else
+			{
+				std::cout << "PASS " << what.toStdString() << std::endl;
+				passed++;
+			}
+		}
+
+		//
+		// Every golden file must have been written again by the paths in the corpus
+		//
+		if (!opts.record)
+		{
+			QStringList written = outdir.entryList(QStringList() << "*.csv", QDir::Files);
+			for (const QString& file : golddir.entryList(QStringList() << "*.csv", QDir::Files))
+			{
+				if (!written.contains(file))
+				{
+					std::cerr << "FAIL " << c.name.toStdString() << "/" << file.toStdString() << ": no output file" << std::endl;
+					failed++;
+				}
+			}
+		}
+
+		if (opts.record)
+		{
+			if (!budgetfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			{
+				std::cerr << "xeropath2-regress: cannot write '" << budgetfile.fileName().toStdString() << "'" << std::endl;
+				return 2;
+			}
+			budgetfile.write(QJsonDocument(budgets).toJson());
+			budgetfile.close();
+		}
+	}
+
+	if (!opts.record)
+		std::cout << passed << " passed, " << failed << " failed" << std::endl;
+
+	return (failed > 0) ? 1 : 0;
+}
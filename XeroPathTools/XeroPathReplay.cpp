@@ -0,0 +1,209 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+//
+// xeropath2-replay - generates a path from a capture file a number of times and prints
+// where the time went.  Run it under perf or another profiler to study a slow path
+// without the project it came from.
+//
+#include "AllocationCounter.h"
+#include "GenerationCapture.h"
+#include "Generator.h"
+#include "GeneratorStats.h"
+#include "PathGroup.h"
+#include "Tracer.h"
+#include "TrajectoryNames.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QTemporaryDir>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+static void usage()
+{
+	std::cerr << "usage: xeropath2-replay [options] CAPTUREFILE" << std::endl;
+	std::cerr << "    --iterations N       the number of timed generations (default: 10)" << std::endl;
+	std::cerr << "    --warmup N           the number of untimed generations first (default: 1)" << std::endl;
+	std::cerr << "    --trace FILE         write a Chrome trace of the timed generations to FILE" << std::endl;
+	std::cerr << std::endl;
+	std::cerr << "capture files are written by xeropath2-cli --capture DIR or Help/Capture Generation Inputs" << std::endl;
+}
+
+static std::string ms(double secs)
+{
+	return QString::number(secs * 1000.0, 'f', 3).rightJustified(12).toStdString();
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication a(argc, argv);
+
+	QString capfile, tracefile;
+	int iterations = 10;
+	int warmup = 1;
+
+	QStringList args = QCoreApplication::arguments();
+	args.pop_front();
+
+	while (args.size() > 0)
+	{
+		QString arg = args.takeFirst();
+
+		if (arg == "--help")
+		{
+			usage();
+			return 0;
+		}
+		else if (arg == "--iterations" || arg == "--warmup" || arg == "--trace")
+		{
+			if (args.size() == 0)
+			{
+				std::cerr << "xeropath2-replay: " << arg.toStdString() << " flag requires an argument" << std::endl;
+				return 2;
+			}
+
+			QString value = args.takeFirst();
+			bool ok = true;
+
+			if (arg == "--trace")
+				tracefile = value;
+			else if (arg == "--iterations")
+			{
+				iterations = value.toInt(&ok);
+				ok = ok && iterations > 0;
+			}
+			else
+			{
+				warmup = value.toInt(&ok);
+				ok = ok && warmup >= 0;
+			}
+
+			if (!ok)
+			{
+				std::cerr << "xeropath2-replay: " << arg.toStdString() << " requires a valid count" << std::endl;
+				return 2;
+			}
+		}
+		else if (arg.startsWith("--") || capfile.length() > 0)
+		{
+			std::cerr << "xeropath2-replay: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return 2;
+		}
+		else
+		{
+			capfile = arg;
+		}
+	}
+
+	if (capfile.length() == 0)
+	{
+		usage();
+		return 2;
+	}
+
+	GenerationCapture capture;
+	QString msg;
+	if (!capture.read(capfile, msg))
+	{
+		std::cerr << "xeropath2-replay: " << msg.toStdString() << std::endl;
+		return 2;
+	}
+
+	auto path = capture.path();
+	auto robot = capture.robot();
+
+	std::cout << "path:       " << path->fullname().toStdString() << " (" << path->size() << " waypoints, " << path->constraints().size() << " constraints)" << std::endl;
+	std::cout << "robot:      " << robot->getName().toStdString() << ", " << ((robot->getDriveType() == RobotParams::DriveType::TankDrive) ? "tank" : "swerve") << std::endl;
+	std::cout << "generator:  " << typeToKey(capture.type()).toStdString() << ", timestep " << capture.timestep() << std::endl;
+
+	//
+	// Allocations are counted whenever the build can count them
+	//
+	AllocationCounter::setEnabled(AllocationCounter::isAvailable());
+
+	QTemporaryDir tmpdir;
+	QString logfile = QDir(tmpdir.path()).absoluteFilePath("generators_log.txt");
+	QMutex loglock;
+
+	QVector<double> times;
+	GeneratorStats total;
+	std::shared_ptr<TrajectoryGroup> group;
+
+	for (int i = 0; i < warmup + iterations; i++)
+	{
+		if (i == warmup)
+			Tracer::setEnabled(tracefile.length() > 0);
+
+		group = std::make_shared<TrajectoryGroup>(capture.type(), path);
+		Generator gen(logfile, loglock, capture.timestep(), robot, group);
+		gen.setResolution(capture.resolution());
+		gen.setWarmStart(capture.warmStart());
+		gen.generateTrajectory();
+
+		if (group->hasError())
+		{
+			std::cerr << "xeropath2-replay: generation failed - " << group->errorMessage().toStdString() << std::endl;
+			return 1;
+		}
+
+		if (i >= warmup)
+		{
+			times.push_back(group->generationTime());
+			total.merge(group->stats());
+		}
+	}
+
+	Tracer::setEnabled(false);
+
+	auto main = group->getTrajectory(TrajectoryName::Main);
+	std::cout << "trajectory: " << main->size() << " points, " << main->getEndTime() << " seconds, " << group->stats().iterations() << " iterations" << std::endl;
+	std::cout << std::endl;
+
+	std::sort(times.begin(), times.end());
+	double sum = 0.0;
+	for (double t : times)
+		sum += t;
+
+	std::cout << "generate ms:   min" << ms(times.front()) << "   median" << ms(times[times.size() / 2]) << "   mean" << ms(sum / times.size()) << "   max" << ms(times.back()) << std::endl;
+	std::cout << std::endl;
+	std::cout << "stage              calls/run   ms/run" << std::endl;
+
+	for (int s = 0; s < GeneratorStats::StageCount; s++)
+	{
+		auto stage = static_cast<GeneratorStats::Stage>(s);
+		std::cout << std::left << std::setw(18) << GeneratorStats::stageName(stage) << std::right << std::setw(10)
+			<< QString::number(static_cast<double>(total.calls(stage)) / iterations, 'f', 1).toStdString()
+			<< ms(total.seconds(stage) / iterations) << std::endl;
+	}
+
+	if (AllocationCounter::isEnabled())
+	{
+		const AllocationStats& allocs = group->allocations();
+		std::cout << std::endl << "allocations: " << allocs.allocations << ", " << allocs.bytes << " bytes, peak " << allocs.peak << " bytes" << std::endl;
+	}
+
+	if (tracefile.length() > 0 && !Tracer::write(tracefile, msg))
+	{
+		std::cerr << "xeropath2-replay: " << msg.toStdString() << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,715 @@
+//
+// Copyright 2022 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+//
+// xeropath2-stress - generates random but plausible paths, checks the generated
+// trajectories against a set of invariants and records the time for each case.
+// Each path is also edited at both ends and in the middle, and the splines it
+// updates are checked against splines made from scratch for the same waypoints.
+// Failing and slow cases are minimized and written out as a corpus of .xeropath
+// fixtures that xeropath2-bench and xeropath2-regress can run directly.
+//
+#include "Corpus.h"
+#include "Generator.h"
+#include "PathGroup.h"
+#include "CentripetalConstraint.h"
+#include "DistanceVelocityConstraint.h"
+#include "SplineSet.h"
+#include "TrajectoryNames.h"
+#include "TrajectoryUtils.h"
+#include "UnitConverter.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMutex>
+#include <QtCore/QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+//
+// A path in a form that is easy to create randomly and to shrink
+//
+struct ConstraintSpec
+{
+	bool centripetal;
+	double after;
+	double before;
+	double value;
+};
+
+struct PathSpec
+{
+	QVector<Pose2dWithRotation> points;
+	QVector<ConstraintSpec> constraints;
+	double maxvel;
+	double maxaccel;
+};
+
+//
+// The result of generating one case, kind is empty if every invariant held
+//
+struct Outcome
+{
+	QString kind;
+	QString detail;
+	double time;
+};
+
+struct Options
+{
+	QString robotfile;
+	QString fieldfile;
+	QString fixturedir = "stress-fixtures";
+	QString reportfile;
+	GeneratorType type = GeneratorType::ErrorCodeXeroSwerve;
+	int cases = 200;
+	int slowest = 3;
+	int maxfixtures = 10;
+	unsigned int seed = 1;
+	double tolerance = 0.01;
+};
+
+static void usage()
+{
+	std::cerr << "usage: xeropath2-stress --robot FILE [options]" << std::endl;
+	std::cerr << "    --robot FILE         the robot JSON file" << std::endl;
+	std::cerr << "    --field FILE         a field JSON file, waypoints are kept inside its field-size (default: 54 x 27 ft)" << std::endl;
+	std::cerr << "    --generator KEY      cheesy or errorcodexeroswerve (default: errorcodexeroswerve)" << std::endl;
+	std::cerr << "    --cases N            the number of random paths (default: 200)" << std::endl;
+	std::cerr << "    --seed N             the random seed (default: 1)" << std::endl;
+	std::cerr << "    --slowest N          the number of slowest passing cases to keep as fixtures (default: 3)" << std::endl;
+	std::cerr << "    --max-fixtures N     the most failing cases to minimize and keep (default: 10)" << std::endl;
+	std::cerr << "    --tolerance V        fraction a velocity may exceed its limit by (default: 0.01)" << std::endl;
+	std::cerr << "    --fixtures DIR       the directory for the fixtures (default: stress-fixtures)" << std::endl;
+	std::cerr << "    --report FILE        write the time and result of every case as JSON to FILE" << std::endl;
+}
+
+static std::shared_ptr<RobotPath> buildPath(const PathGroup* group, const QString& units, const QString& name, const PathSpec& spec)
+{
+	auto path = std::make_shared<RobotPath>(group, units, name, PathParameters(0.0, 0.0, spec.maxvel, spec.maxaccel));
+
+	for (const Pose2dWithRotation& pt : spec.points)
+		path->addWayPoint(pt);
+
+	for (const ConstraintSpec& c : spec.constraints)
+	{
+		if (c.centripetal)
+			path->addConstraint(std::make_shared<CentripetalConstraint>(path, c.value), false);
+		else
+			path->addConstraint(std::make_shared<DistanceVelocityConstraint>(path, c.after, c.before, c.value), false);
+	}
+
+	return path;
+}
+
+static PathSpec randomPath(std::mt19937& rng, double width, double height, std::shared_ptr<RobotParams> robot)
+{
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	std::uniform_int_distribution<int> npoints(2, 6);
+	std::uniform_int_distribution<int> nconstraints(0, 2);
+	PathSpec spec;
+	double length = 0.0;
+
+	int count = npoints(rng);
+	while (spec.points.size() < count)
+	{
+		Translation2d pos(width * (0.1 + 0.8 * unit(rng)), height * (0.1 + 0.8 * unit(rng)));
+		if (spec.points.size() > 0)
+		{
+			double dist = pos.distance(spec.points.back().getTranslation());
+			if (dist < width * 0.05)
+				continue;
+			length += dist;
+		}
+
+		Rotation2d heading = Rotation2d::fromDegrees(unit(rng) * 360.0 - 180.0);
+		Rotation2d swrot = Rotation2d::fromDegrees(unit(rng) * 360.0 - 180.0);
+		Pose2dWithRotation pt(pos, heading, swrot);
+		pt.setRotVelocity(unit(rng) < 0.5 ? 0.0 : unit(rng) * 180.0 - 90.0);
+		spec.points.push_back(pt);
+	}
+
+	spec.maxvel = robot->getMaxVelocity() * (0.3 + 0.7 * unit(rng));
+	spec.maxaccel = robot->getMaxAccel() * (0.3 + 0.7 * unit(rng));
+
+	int ncons = nconstraints(rng);
+	for (int i = 0; i < ncons; i++)
+	{
+		ConstraintSpec c;
+		c.centripetal = unit(rng) < 0.5;
+		if (c.centripetal)
+		{
+			c.after = 0.0;
+			c.before = 0.0;
+			c.value = 100.0 + unit(rng) * 900.0;
+		}
+		else
+		{
+			c.after = unit(rng) * length * 0.8;
+			c.before = c.after + length * (0.1 + 0.3 * unit(rng));
+			c.value = spec.maxvel * (0.2 + 0.6 * unit(rng));
+		}
+		spec.constraints.push_back(c);
+	}
+
+	return spec;
+}
+
+static bool finite(const Pose2dWithTrajectory& pt)
+{
+	return std::isfinite(pt.x()) && std::isfinite(pt.y()) && std::isfinite(pt.time()) && std::isfinite(pt.position()) &&
+		std::isfinite(pt.velocity()) && std::isfinite(pt.acceleration()) && std::isfinite(pt.curvature()) && std::isfinite(pt.rotVel());
+}
+
+//
+// Checks the invariants of a generated group, returning the kind of the first failure or an empty string
+//
+static QString checkGroup(std::shared_ptr<TrajectoryGroup> group, const PathSpec& spec, std::shared_ptr<RobotParams> robot, double tol, QString& detail)
+{
+	auto main = group->getTrajectory(TrajectoryName::Main);
+	if (main == nullptr || main->size() == 0)
+	{
+		detail = "no main trajectory";
+		return "empty";
+	}
+
+	QString units = group->path()->units();
+	double robotmax = UnitConverter::convert(robot->getMaxVelocity(), robot->getLengthUnits(), units);
+	double length = UnitConverter::convert(robot->getWheelBaseLength(), robot->getLengthUnits(), units);
+	double width = UnitConverter::convert(robot->getWheelBaseWidth(), robot->getLengthUnits(), units);
+
+	for (int i = 0; i < main->size(); i++)
+	{
+		const Pose2dWithTrajectory& pt = (*main)[i];
+		QString where = "point " + QString::number(i) + " (t = " + QString::number(pt.time(), 'f', 3) + ")";
+
+		if (!finite(pt))
+		{
+			detail = where + " has a value that is not finite";
+			return "nan";
+		}
+
+		if (i > 0 && pt.time() <= (*main)[i - 1].time())
+		{
+			detail = where + " time does not increase";
+			return "time";
+		}
+
+		if (i > 0 && pt.position() < (*main)[i - 1].position() - 1e-6)
+		{
+			detail = where + " position decreases";
+			return "position";
+		}
+
+		if (pt.velocity() < -1e-6 || pt.velocity() > spec.maxvel * (1.0 + tol) + 1e-6)
+		{
+			detail = where + " velocity " + QString::number(pt.velocity()) + " outside 0 - " + QString::number(spec.maxvel);
+			return "velocity";
+		}
+
+		if (robot->getDriveType() == RobotParams::DriveType::SwerveDrive)
+		{
+			//
+			// Each module moves with the robot plus the velocity needed to rotate the robot
+			//
+			double rv = UnitConverter::convert(TrajectoryUtils::rotationalToLinear(robot, pt.rotVel()), robot->getLengthUnits(), units);
+			Translation2d pathvel(pt.rotation(), pt.velocity());
+			const double dx[] = { length / 2.0, length / 2.0, -length / 2.0, -length / 2.0 };
+			const double dy[] = { width / 2.0, -width / 2.0, width / 2.0, -width / 2.0 };
+
+			for (int w = 0; w < 4; w++)
+			{
+				double dist = std::sqrt(dx[w] * dx[w] + dy[w] * dy[w]);
+				Translation2d rotvel = Translation2d(-dy[w] / dist * rv, dx[w] / dist * rv).rotateBy(pt.swrot());
+				double speed = (rotvel + pathvel).normalize();
+				if (speed > robotmax * (1.0 + tol) + 1e-6)
+				{
+					detail = where + " module " + QString::number(w) + " speed " + QString::number(speed) + " exceeds " + QString::number(robotmax);
+					return "module";
+				}
+			}
+		}
+	}
+
+	if (robot->getDriveType() == RobotParams::DriveType::TankDrive)
+	{
+		for (const char* name : { TrajectoryName::Left, TrajectoryName::Right })
+		{
+			auto side = group->getTrajectory(name);
+			if (side == nullptr)
+				continue;
+
+			for (int i = 0; i < side->size(); i++)
+			{
+				double vel = std::fabs((*side)[i].velocity());
+				if (!std::isfinite(vel) || vel > robotmax * (1.0 + tol) + 1e-6)
+				{
+					detail = QString(name) + " point " + QString::number(i) + " velocity " + QString::number(vel) + " exceeds " + QString::number(robotmax);
+					return "module";
+				}
+			}
+		}
+	}
+
+	return "";
+}
+
+//
+// True if two spline sets hold exactly the same splines, lengths and distances
+//
+static bool sameSplines(const SplineSet& a, const SplineSet& b)
+{
+	if (a.size() != b.size() || a.distances() != b.distances())
+		return false;
+
+	for (int i = 0; i < a.size(); i++)
+	{
+		const SplinePair& p = a[i];
+		const SplinePair& q = b[i];
+
+		if (a.length(i) != b.length(i) ||
+			p.x0() != q.x0() || p.x1() != q.x1() || p.dx0() != q.dx0() || p.dx1() != q.dx1() || p.ddx0() != q.ddx0() || p.ddx1() != q.ddx1() ||
+			p.y0() != q.y0() || p.y1() != q.y1() || p.dy0() != q.dy0() || p.dy1() != q.dy1() || p.ddy0() != q.ddy0() || p.ddy1() != q.ddy1())
+			return false;
+	}
+
+	return true;
+}
+
+class Runner
+{
+public:
+	Runner(std::shared_ptr<RobotParams> robot, GeneratorType type, double tol, const QString& logfile)
+		: group_("stress"), logfile_(logfile) {
+		robot_ = robot;
+		type_ = type;
+		tol_ = tol;
+	}
+
+	Outcome run(const PathSpec& spec, const QString& name) {
+		Outcome out;
+		auto path = buildPath(&group_, robot_->getLengthUnits(), name, spec);
+		auto group = std::make_shared<TrajectoryGroup>(type_, path);
+		Generator gen(logfile_, loglock_, 0.02, robot_, group);
+
+		QElapsedTimer timer;
+		timer.start();
+		gen.generateTrajectory();
+		out.time = timer.nsecsElapsed() / 1.0e9;
+
+		if (group->hasError())
+		{
+			out.kind = "error";
+			out.detail = group->errorMessage();
+		}
+		else
+		{
+			out.kind = checkGroup(group, spec, robot_, tol_, out.detail);
+		}
+
+		if (out.kind.length() == 0)
+		{
+			out.kind = checkEdits(spec, name, out.detail);
+		}
+
+		return out;
+	}
+
+	//
+	// Inserts and removes a waypoint at each end of the path and moves one in the middle.
+	// After each edit the splines the path updated from the ones before the edit must be
+	// the same as the splines made from scratch for its waypoints.
+	//
+	QString checkEdits(const PathSpec& spec, const QString& name, QString& detail) {
+		auto path = buildPath(&group_, robot_->getLengthUnits(), name, spec);
+		path->splines();
+
+		const Pose2dWithRotation& first = spec.points.front();
+		const Pose2dWithRotation& last = spec.points.back();
+		Translation2d outstart = first.getTranslation().translateBy(spec.points[1].getTranslation().inverse()).scale(0.5);
+		Translation2d outend = last.getTranslation().translateBy(spec.points[spec.points.size() - 2].getTranslation().inverse()).scale(0.5);
+
+		Pose2dWithRotation before(first.getTranslation() + outstart, first.getRotation(), first.getSwrot());
+		Pose2dWithRotation after(last.getTranslation() + outend, last.getRotation(), last.getSwrot());
+
+		for (int edit = 0; edit < 5; edit++)
+		{
+			QString what;
+
+			switch (edit)
+			{
+			case 0:
+				what = "inserting a first waypoint";
+				path->insertPoint(-1, before, false);
+				break;
+			case 1:
+				what = "inserting a last waypoint";
+				path->insertPoint(path->size() - 1, after, false);
+				break;
+			case 2:
+				{
+					what = "moving a middle waypoint";
+					int index = path->size() / 2;
+					const Pose2dWithRotation& pt = path->getPoint(index);
+					Pose2dWithRotation moved(pt.getTranslation() + outstart, pt.getRotation(), pt.getSwrot());
+					path->replacePoint(index, moved, false);
+				}
+				break;
+			case 3:
+				what = "removing the first waypoint";
+				path->removePoint(0, false);
+				break;
+			case 4:
+				what = "removing the last waypoint";
+				path->removePoint(path->size() - 1, false);
+				break;
+			}
+
+			if (!sameSplines(*path->splines(), SplineSet(path->waypoints())))
+			{
+				detail = "the splines updated after " + what + " differ from splines made from scratch";
+				return "splines";
+			}
+		}
+
+		return "";
+	}
+
+	QJsonObject toJSON(const PathSpec& spec, const QString& name) {
+		auto path = buildPath(&group_, robot_->getLengthUnits(), name, spec);
+		return path->toJSONObject();
+	}
+
+	const QString& units() const {
+		return robot_->getLengthUnits();
+	}
+
+private:
+	PathGroup group_;
+	std::shared_ptr<RobotParams> robot_;
+	GeneratorType type_;
+	double tol_;
+	const QString& logfile_;
+	QMutex loglock_;
+};
+
+//
+// Greedily removes waypoints and constraints, and zeros rotations, while the case still
+// shows the same problem.  For a slow case the problem is taking at least half as long.
+//
+static PathSpec minimize(Runner& runner, PathSpec spec, const Outcome& original)
+{
+	auto same = [&runner, &original](const PathSpec& candidate) {
+		Outcome out = runner.run(candidate, "minimize");
+		if (original.kind.length() == 0)
+			return out.kind.length() == 0 && out.time >= original.time * 0.5;
+		return out.kind == original.kind;
+	};
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		for (int i = 0; i < spec.points.size() && spec.points.size() > 2; i++)
+		{
+			PathSpec candidate = spec;
+			candidate.points.removeAt(i);
+			if (same(candidate))
+			{
+				spec = candidate;
+				changed = true;
+				i--;
+			}
+		}
+
+		for (int i = 0; i < spec.constraints.size(); i++)
+		{
+			PathSpec candidate = spec;
+			candidate.constraints.removeAt(i);
+			if (same(candidate))
+			{
+				spec = candidate;
+				changed = true;
+				i--;
+			}
+		}
+
+		for (int i = 0; i < spec.points.size(); i++)
+		{
+			const Pose2dWithRotation& pt = spec.points[i];
+			if (pt.getSwrotVelocity() == 0.0 && pt.getSwrot().toDegrees() == 0.0)
+				continue;
+
+			PathSpec candidate = spec;
+			Pose2dWithRotation simpler(pt.getTranslation(), pt.getRotation(), Rotation2d::fromDegrees(0.0));
+			candidate.points[i] = simpler;
+			if (same(candidate))
+			{
+				spec = candidate;
+				changed = true;
+			}
+		}
+	}
+
+	return spec;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication a(argc, argv);
+	Options opts;
+
+	QStringList args = QCoreApplication::arguments();
+	args.pop_front();
+
+	while (args.size() > 0)
+	{
+		QString arg = args.takeFirst();
+
+		if (arg == "--help")
+		{
+			usage();
+			return 0;
+		}
+
+		if (args.size() == 0)
+		{
+			std::cerr << "xeropath2-stress: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return 2;
+		}
+
+		QString value = args.takeFirst();
+		bool ok = true;
+
+		if (arg == "--robot")
+			opts.robotfile = value;
+		else if (arg == "--field")
+			opts.fieldfile = value;
+		else if (arg == "--fixtures")
+			opts.fixturedir = value;
+		else if (arg == "--report")
+			opts.reportfile = value;
+		else if (arg == "--generator")
+			ok = (opts.type = keyToType(value)) != GeneratorType::None;
+		else if (arg == "--cases")
+			opts.cases = value.toInt(&ok);
+		else if (arg == "--seed")
+			opts.seed = value.toUInt(&ok);
+		else if (arg == "--slowest")
+			opts.slowest = value.toInt(&ok);
+		else if (arg == "--max-fixtures")
+			opts.maxfixtures = value.toInt(&ok);
+		else if (arg == "--tolerance")
+			opts.tolerance = value.toDouble(&ok);
+		else
+		{
+			std::cerr << "xeropath2-stress: invalid argument '" << arg.toStdString() << "'" << std::endl;
+			usage();
+			return 2;
+		}
+
+		if (!ok)
+		{
+			std::cerr << "xeropath2-stress: invalid value '" << value.toStdString() << "' for " << arg.toStdString() << std::endl;
+			return 2;
+		}
+	}
+
+	if (opts.robotfile.length() == 0)
+	{
+		usage();
+		return 2;
+	}
+
+	QString msg;
+	auto robot = Corpus::loadRobot(opts.robotfile, msg);
+	if (robot == nullptr)
+	{
+		std::cerr << "xeropath2-stress: " << msg.toStdString() << std::endl;
+		return 2;
+	}
+
+	//
+	// The field size bounds the waypoints, in the units of the robot
+	//
+	double width = UnitConverter::convert(54.0, "ft", robot->getLengthUnits());
+	double height = UnitConverter::convert(27.0, "ft", robot->getLengthUnits());
+	if (opts.fieldfile.length() > 0)
+	{
+		QFile file(opts.fieldfile);
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			std::cerr << "xeropath2-stress: cannot open field file '" << opts.fieldfile.toStdString() << "'" << std::endl;
+			return 2;
+		}
+
+		QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+		QJsonArray size = obj.value("field-size").toArray();
+		if (size.size() != 2 || !obj.value("field-unit").isString())
+		{
+			std::cerr << "xeropath2-stress: field file '" << opts.fieldfile.toStdString() << "' has no field-size and field-unit" << std::endl;
+			return 2;
+		}
+		width = UnitConverter::convert(size.at(0).toDouble(), obj.value("field-unit").toString(), robot->getLengthUnits());
+		height = UnitConverter::convert(size.at(1).toDouble(), obj.value("field-unit").toString(), robot->getLengthUnits());
+	}
+
+	QTemporaryDir tmpdir;
+	QString logfile = QDir(tmpdir.path()).absoluteFilePath("generators_log.txt");
+	Runner runner(robot, opts.type, opts.tolerance, logfile);
+	std::mt19937 rng(opts.seed);
+
+	QVector<PathSpec> specs;
+	QVector<Outcome> outcomes;
+	QJsonArray report;
+	int failed = 0;
+
+	for (int i = 0; i < opts.cases; i++)
+	{
+		PathSpec spec = randomPath(rng, width, height, robot);
+		Outcome out = runner.run(spec, "case" + QString::number(i));
+
+		specs.push_back(spec);
+		outcomes.push_back(out);
+
+		QJsonObject obj;
+		obj["case"] = i;
+		obj["waypoints"] = spec.points.size();
+		obj["constraints"] = spec.constraints.size();
+		obj["time"] = out.time;
+		obj["status"] = (out.kind.length() > 0) ? out.kind : "ok";
+		if (out.detail.length() > 0)
+			obj["detail"] = out.detail;
+		report.append(obj);
+
+		if (out.kind.length() > 0)
+		{
+			std::cout << "case " << i << ": " << out.kind.toStdString() << " - " << out.detail.toStdString() << std::endl;
+			failed++;
+		}
+	}
+
+	//
+	// The failing cases, then the slowest passing cases, are minimized into fixtures
+	//
+	QVector<int> keep;
+	for (int i = 0; i < outcomes.size() && keep.size() < opts.maxfixtures; i++)
+	{
+		if (outcomes[i].kind.length() > 0)
+			keep.push_back(i);
+	}
+
+	QVector<int> passing;
+	for (int i = 0; i < outcomes.size(); i++)
+	{
+		if (outcomes[i].kind.length() == 0)
+			passing.push_back(i);
+	}
+	std::sort(passing.begin(), passing.end(), [&outcomes](int a, int b) { return outcomes[a].time > outcomes[b].time; });
+	for (int i = 0; i < passing.size() && i < opts.slowest; i++)
+		keep.push_back(passing[i]);
+
+	QDir fixdir(opts.fixturedir);
+	if (keep.size() > 0)
+	{
+		if (!fixdir.exists() && !fixdir.mkpath(fixdir.absolutePath()))
+		{
+			std::cerr << "xeropath2-stress: cannot create '" << fixdir.absolutePath().toStdString() << "'" << std::endl;
+			return 2;
+		}
+
+		QFile::remove(fixdir.absoluteFilePath("robot.json"));
+		QFile::copy(opts.robotfile, fixdir.absoluteFilePath("robot.json"));
+	}
+
+	QJsonArray cases;
+	for (int index : keep)
+	{
+		const Outcome& out = outcomes[index];
+		QString kind = (out.kind.length() > 0) ? out.kind : "slow";
+		QString name = kind + "-" + QString::number(opts.seed) + "-" + QString::number(index);
+
+		std::cout << "minimizing case " << index << " (" << kind.toStdString() << ")" << std::endl;
+		PathSpec small = minimize(runner, specs[index], out);
+
+		QJsonObject group;
+		group["name"] = "stress";
+		group["paths"] = QJsonArray({ runner.toJSON(small, name) });
+
+		QJsonObject model;
+		model["_version"] = "3";
+		model["units"] = runner.units();
+		model["generator"] = typeToKey(opts.type);
+		model["outdir"] = "";
+		model["groups"] = QJsonArray({ group });
+
+		QFile file(fixdir.absoluteFilePath(name + ".xeropath"));
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			std::cerr << "xeropath2-stress: cannot write '" << file.fileName().toStdString() << "'" << std::endl;
+			return 2;
+		}
+		file.write(QJsonDocument(model).toJson());
+		file.close();
+
+		QJsonObject c;
+		c[Corpus::NameTag] = name;
+		c[Corpus::PathsTag] = name + ".xeropath";
+		c[Corpus::RobotTag] = "robot.json";
+		cases.append(c);
+	}
+
+	if (cases.size() > 0)
+	{
+		QJsonObject manifest;
+		manifest[Corpus::CasesTag] = cases;
+
+		QFile file(fixdir.absoluteFilePath(Corpus::ManifestName));
+		if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			file.write(QJsonDocument(manifest).toJson());
+			file.close();
+		}
+	}
+
+	if (opts.reportfile.length() > 0)
+	{
+		QJsonObject obj;
+		obj["seed"] = static_cast<qint64>(opts.seed);
+		obj["robot"] = robot->getName();
+		obj["generator"] = typeToKey(opts.type);
+		obj["cases"] = report;
+
+		QFile file(opts.reportfile);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			std::cerr << "xeropath2-stress: cannot write '" << opts.reportfile.toStdString() << "'" << std::endl;
+			return 2;
+		}
+		file.write(QJsonDocument(obj).toJson());
+		file.close();
+	}
+
+	std::cout << opts.cases << " cases, " << failed << " failed, " << cases.size() << " fixtures written" << std::endl;
+	return (failed > 0) ? 1 : 0;
+}
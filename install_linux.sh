@@ -15,6 +15,7 @@ mkdir -p ~/.local/opt/xeropath2
 cat xeropath2.desktop | envsubst > ~/.local/share/applications/xeropath2.desktop
 
 cp xeropath2 ~/.local/opt/xeropath2
+cp xeropath2-cli ~/.local/opt/xeropath2
 cp -r XeroPathGen/images ~/.local/opt/xeropath2
 
 